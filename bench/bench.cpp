@@ -0,0 +1,327 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "levelsimulation.hpp"
+#include "awakeset.hpp"
+#include "objectpool.hpp"
+#include "towerlevel.hpp"
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// Runs named physics scenarios headless and reports their timings, for comparing commits.
+//
+// usage: angry_birds_bench [options]
+//   --scenario <name>               run the scenarios whose name starts with <name>, default all
+//   --steps <n>                     physics steps of each stepped scenario, default 600
+//   --repeat <n>                    loads of each level in the load scenarios, default 20
+//   --format json|csv               output format, default json
+//   --output <file>                 write the results to a file instead of the standard output
+//   --list                          print the names of the scenarios and exit
+//
+// Scenarios:
+//   load/<n>        build bundled level n from its file, repeated
+//   settle/<n>      let bundled level n come to rest without a shot
+//   shot/3          launch the first bird of level 3 into its structure
+//   collapse/5000   a shot into 5000 blocks of generated towers, checked to stand before the shot
+//   storm/sandbox   two objects spawned every step at the spawn point of the sandbox, as if its buttons were mashed
+//
+// Every scenario steps by LevelSimulation::kTimeStep and draws its random numbers from a fixed
+// seed, so the same commit simulates the same thing on every run. Only the wall time differs.
+// Peak RSS is the peak of the whole process when the scenario ends, run a scenario alone with
+// --scenario to get its own.
+
+namespace {
+    constexpr unsigned kSeed = 1;
+    constexpr int kStormPerStep = 2;
+    constexpr int kSettleSteps = 120;      // untimed steps before the shot of collapse/5000
+
+    struct Result {
+        std::string name;
+        int runs = 0;                   // loads or steps timed
+        double loadMs = 0;              // median of the loads, or the one load of a stepped scenario
+        double loadMsP99 = 0;
+        double stepMsMedian = 0;
+        double stepMsP99 = 0;
+        double contactsPerStep = 0;
+        int bodies = 0;                 // bodies in the world at the end
+        long peakRssKb = 0;
+    };
+
+    struct Scenario {
+        std::string name;
+        std::function<Result(const std::string&, int, int)> run;    // name, steps, repeat
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    double percentile(std::vector<double> values, double percent) {
+        if (values.empty()) { return 0; }
+        std::size_t rank = static_cast<std::size_t>(percent / 100 * (values.size() - 1) + 0.5);
+        std::nth_element(values.begin(), values.begin() + rank, values.end());
+        return values[rank];
+    }
+
+    long peakRssKb() {
+#ifdef _WIN32
+        return 0;
+#else
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024;     // bytes on macOS
+#else
+        return usage.ru_maxrss;
+#endif
+#endif
+    }
+
+    // Times each step of a world, sync included, and fills the step fields of a result.
+    void timeSteps(Result& result, int steps, b2World& world, const std::function<void(int)>& step) {
+        std::vector<double> times;
+        times.reserve(steps);
+        long contacts = 0;
+        for (int i = 0; i < steps; i++) {
+            auto start = Clock::now();
+            step(i);
+            times.push_back(millisecondsSince(start));
+            contacts += world.GetContactCount();
+        }
+        result.runs = steps;
+        result.stepMsMedian = percentile(times, 50);
+        result.stepMsP99 = percentile(times, 99);
+        result.contactsPerStep = steps > 0 ? double(contacts) / steps : 0;
+        result.bodies = world.GetBodyCount();
+    }
+
+    Result loadLevel(const std::string& name, int level, int repeat) {
+        Result result;
+        result.name = name;
+        std::vector<double> times;
+        for (int i = 0; i < repeat; i++) {
+            auto start = Clock::now();
+            LevelSimulation simulation{ LevelData(level) };
+            times.push_back(millisecondsSince(start));
+            result.bodies = simulation.getWorld().GetBodyCount();
+        }
+        result.runs = repeat;
+        result.loadMs = percentile(times, 50);
+        result.loadMsP99 = percentile(times, 99);
+        return result;
+    }
+
+    std::vector<int> hpOf(LevelSimulation& simulation) {
+        std::vector<int> hp;
+        for (auto& pig : simulation.getPigs()) { hp.push_back(pig->getHp()); }
+        for (auto& obstacle : simulation.getObstacles()) { hp.push_back(obstacle->getHp()); }
+        return hp;
+    }
+
+    // Loads a level, optionally settles and shoots its first bird, and times the steps.
+    // The settling steps are not timed, and the level must not lose any hp during them.
+    Result stepLevel(const std::string& name, const std::string& path, int steps, bool shoot, int settleSteps = 0) {
+        Result result;
+        result.name = name;
+        auto start = Clock::now();
+        LevelSimulation simulation{ LevelData(path) };
+        result.loadMs = millisecondsSince(start);
+        result.loadMsP99 = result.loadMs;
+        if (settleSteps > 0) {
+            std::vector<int> before = hpOf(simulation);
+            simulation.step(settleSteps);
+            simulation.clearSounds();
+            if (hpOf(simulation) != before) {
+                throw std::runtime_error("The level of " + name + " does not stand on its own!");
+            }
+        }
+        if (shoot) {
+            simulation.launch(0, LevelSimulation::impulseFromOffset(sf::Vector2f(-90, 20)));
+        }
+        timeSteps(result, steps, simulation.getWorld(), [&simulation](int) {
+            simulation.step();
+            simulation.clearSounds();
+        });
+        return result;
+    }
+
+    // Writes towers of 10 layers until 5000 blocks are placed, in the format of the level files.
+    std::string writeCollapseLevel() {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "angry_birds_bench_collapse.txt";
+        std::ofstream file(path);
+        if (!file) {
+            throw std::runtime_error("Failed opening the file " + path.string() + " for writing!");
+        }
+        TowerLevel::Options options;
+        options.blocks = 5000;
+        options.birds = 2;
+        options.seed = kSeed;
+        TowerLevel(options).write(file);
+        if (!file) {
+            throw std::runtime_error("Failed writing the file " + path.string() + "!");
+        }
+        return path.string();
+    }
+
+    // Spawns objects into an empty sandbox world the way SandboxState::createObject() does.
+    Result spawnStorm(const std::string& name, int steps) {
+        Result result;
+        result.name = name;
+        auto start = Clock::now();
+        b2World world(b2Vec2(0.0f, LevelSimulation::kGravity));
+        LevelData data(4);
+        std::shared_ptr<Ground> ground = data.getGround();
+        ground->initializePhysicsWorld(world);
+        ground->setData();
+        ground->moveBodyDown(0.05f);
+        AwakeSet awake;
+        AwakeListener listener(awake);
+        world.SetContactListener(&listener);
+        auto pool = std::make_shared<ObjectPool>();
+        std::vector<std::shared_ptr<Object>> objects;
+        for (auto& obstacle : data.getObstacles()) { obstacle->initializePhysicsWorld(world); objects.push_back(obstacle); }
+        for (auto& pig : data.getPigs()) { pig->initializePhysicsWorld(world); objects.push_back(pig); }
+        result.loadMs = millisecondsSince(start);
+        result.loadMsP99 = result.loadMs;
+
+        std::mt19937 random(kSeed);
+        std::uniform_int_distribution<int> kind(0, 3);
+        std::uniform_real_distribution<double> jitter(-1, 1);    // a pixel, so the spawned objects do not sit exactly on each other
+        timeSteps(result, steps, world, [&](int) {
+            for (int i = 0; i < kStormPerStep; i++) {
+                double x = 683 + jitter(random);
+                std::shared_ptr<Object> object;
+                switch (kind(random)) {
+                    case 0: { object = ObjectPool::make<WoodObstacle>(pool, x, 0); break; }
+                    case 1: { object = ObjectPool::make<StoneObstacle>(pool, x, 0); break; }
+                    case 2: { object = ObjectPool::make<GlassObstacle>(pool, x, 0); break; }
+                    default: { object = ObjectPool::make<NormalPig>(pool, x, 0); break; }
+                }
+                object->initializePhysicsWorld(world);
+                awake.add(object.get());
+                objects.push_back(object);
+            }
+            awake.savePreviousTransforms();
+            world.Step(LevelSimulation::kTimeStep, 8, 3);
+            awake.update(1.0f);
+        });
+        awake.clear();
+        return result;
+    }
+
+    std::vector<Scenario> scenarios() {
+        std::vector<Scenario> list;
+        for (int level = 1; level <= 3; level++) {
+            list.push_back(Scenario{ "load/" + std::to_string(level),
+                [level](const std::string& name, int, int repeat) { return loadLevel(name, level, repeat); } });
+        }
+        for (int level = 1; level <= 3; level++) {
+            list.push_back(Scenario{ "settle/" + std::to_string(level),
+                [level](const std::string& name, int steps, int) { return stepLevel(name, LevelData::getLevelPath(level), steps, false); } });
+        }
+        list.push_back(Scenario{ "shot/3",
+            [](const std::string& name, int steps, int) { return stepLevel(name, LevelData::getLevelPath(3), steps, true); } });
+        list.push_back(Scenario{ "collapse/5000",
+            [](const std::string& name, int steps, int) { return stepLevel(name, writeCollapseLevel(), steps, true, kSettleSteps); } });
+        list.push_back(Scenario{ "storm/sandbox",
+            [](const std::string& name, int steps, int) { return spawnStorm(name, steps); } });
+        return list;
+    }
+
+    void writeCsv(std::ostream& out, const std::vector<Result>& results) {
+        out << "scenario,runs,load_ms,load_ms_p99,step_ms_median,step_ms_p99,contacts_per_step,bodies,peak_rss_kb\n";
+        for (const Result& r : results) {
+            out << r.name << ',' << r.runs << ',' << r.loadMs << ',' << r.loadMsP99 << ',' << r.stepMsMedian << ','
+                << r.stepMsP99 << ',' << r.contactsPerStep << ',' << r.bodies << ',' << r.peakRssKb << '\n';
+        }
+    }
+
+    void writeJson(std::ostream& out, const std::vector<Result>& results, int steps) {
+        out << "{\n  \"seed\": " << kSeed << ", \"time_step\": " << LevelSimulation::kTimeStep << ", \"steps\": " << steps
+            << ",\n  \"scenarios\": [\n";
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const Result& r = results[i];
+            out << "    {\"scenario\": \"" << r.name << "\", \"runs\": " << r.runs
+                << ", \"load_ms\": " << r.loadMs << ", \"load_ms_p99\": " << r.loadMsP99
+                << ", \"step_ms_median\": " << r.stepMsMedian << ", \"step_ms_p99\": " << r.stepMsP99
+                << ", \"contacts_per_step\": " << r.contactsPerStep << ", \"bodies\": " << r.bodies
+                << ", \"peak_rss_kb\": " << r.peakRssKb << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    int usage(const char* program) {
+        std::cerr << "usage: " << program << " [--scenario <name>] [--steps <n>] [--repeat <n>] [--format json|csv]"
+                  << " [--output <file>] [--list]" << std::endl;
+        return 1;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    int steps = 600;
+    int repeat = 20;
+    std::string format = "json";
+    std::string output;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--list") {
+                for (const Scenario& scenario : scenarios()) { std::cout << scenario.name << "\n"; }
+                return 0;
+            }
+            else if (i + 1 >= argc) { return usage(argv[0]); }
+            else if (arg == "--scenario") { filter = argv[++i]; }
+            else if (arg == "--steps") { steps = std::stoi(argv[++i]); }
+            else if (arg == "--repeat") { repeat = std::stoi(argv[++i]); }
+            else if (arg == "--format") { format = argv[++i]; }
+            else if (arg == "--output") { output = argv[++i]; }
+            else { return usage(argv[0]); }
+        }
+        if (steps < 1 || repeat < 1 || (format != "json" && format != "csv")) {
+            return usage(argv[0]);
+        }
+
+        std::vector<Result> results;
+        for (const Scenario& scenario : scenarios()) {
+            if (scenario.name.compare(0, filter.size(), filter) != 0) {
+                continue;
+            }
+            std::cerr << scenario.name << "..." << std::endl;
+            Result result = scenario.run(scenario.name, steps, repeat);
+            result.peakRssKb = peakRssKb();
+            results.push_back(result);
+        }
+        if (results.empty()) {
+            std::cerr << "No scenario starts with " << filter << "!" << std::endl;
+            return 1;
+        }
+
+        std::ofstream file;
+        if (!output.empty()) {
+            file.open(output);
+            if (!file) {
+                throw std::runtime_error("Failed opening the file " + output + " for writing!");
+            }
+        }
+        std::ostream& out = output.empty() ? std::cout : file;
+        if (format == "csv") { writeCsv(out, results); }
+        else { writeJson(out, results, steps); }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
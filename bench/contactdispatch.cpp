@@ -0,0 +1,136 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "levelsimulation.hpp"
+
+// Measures how many contacts per second the collision listener can classify, comparing
+// the string tags it used to compare with the rule table of CollisionListener.
+//
+// usage: angry_birds_bench_contacts [level] [contacts]
+//
+// The contacts are recorded from a shot at the level, so the mix of types is the one of
+// a real collapse, and replayed until the requested number of contacts is reached.
+
+namespace {
+    struct Pair {
+        ObjectType a, b;
+        bool dynamicA, dynamicB;
+    };
+
+    class Recorder : public b2ContactListener {
+    public:
+        void BeginContact(b2Contact* contact) override {
+            b2Body* bodyA = contact->GetFixtureA()->GetBody();
+            b2Body* bodyB = contact->GetFixtureB()->GetBody();
+            Userdata* dataA = reinterpret_cast<Userdata*>(bodyA->GetUserData().pointer);
+            Userdata* dataB = reinterpret_cast<Userdata*>(bodyB->GetUserData().pointer);
+            pairs.push_back(Pair{ dataA->type, dataB->type,
+                bodyA->GetType() == b2_dynamicBody, bodyB->GetType() == b2_dynamicBody });
+        }
+
+        std::vector<Pair> pairs;
+    };
+
+    const char* tagName(ObjectType type) {
+        switch (type) {
+            case ObjectType::Bird: { return "bird"; }
+            case ObjectType::Pig: { return "pig"; }
+            case ObjectType::Obstacle: { return "obstacle"; }
+            case ObjectType::Ground: { return "ground"; }
+            case ObjectType::Star: { return "star"; }
+            default: { return ""; }
+        }
+    }
+
+    // the comparisons BeginContact made before the rule table
+    void legacyRules(const std::string& a, const std::string& b, bool dynamicA, bool dynamicB,
+                     std::uint8_t& ruleA, std::uint8_t& ruleB) {
+        ruleA = 0;
+        ruleB = 0;
+        if (a != "ground") { ruleA |= CollisionListener::Speak; }
+        if (b != "ground") { ruleB |= CollisionListener::Speak; }
+        if (a == "bird") { ruleA |= CollisionListener::Land; }
+        if (b == "bird") { ruleB |= CollisionListener::Land; }
+        if (a != "ground" && (dynamicA || a == "star")) { ruleA |= CollisionListener::Damage; }
+        if (b != "ground" && (dynamicB || b == "star")) { ruleB |= CollisionListener::Damage; }
+        if ((a == "obstacle" && b == "bird") || (b == "obstacle" && a == "bird")) { ruleA |= CollisionListener::Score; }
+    }
+
+    // the same decisions from the rule table
+    void tableRules(ObjectType a, ObjectType b, bool dynamicA, bool dynamicB, std::uint8_t& ruleA, std::uint8_t& ruleB) {
+        const CollisionListener::RuleTable& table = CollisionListener::rules();
+        std::uint8_t fullA = table[static_cast<std::size_t>(a)][static_cast<std::size_t>(b)];
+        std::uint8_t fullB = table[static_cast<std::size_t>(b)][static_cast<std::size_t>(a)];
+        // reduce to the flags legacyRules() reports, so the two can be checked against each other
+        ruleA = fullA & (CollisionListener::Speak | CollisionListener::Land);
+        ruleB = fullB & (CollisionListener::Speak | CollisionListener::Land);
+        if ((fullA & CollisionListener::Collect) || ((fullA & CollisionListener::Damage) && dynamicA)) { ruleA |= CollisionListener::Damage; }
+        if ((fullB & CollisionListener::Collect) || ((fullB & CollisionListener::Damage) && dynamicB)) { ruleB |= CollisionListener::Damage; }
+        if ((fullA | fullB) & CollisionListener::Score) { ruleA |= CollisionListener::Score; }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int level = argc > 1 ? std::stoi(argv[1]) : 1;
+    std::size_t contacts = argc > 2 ? std::stoul(argv[2]) : 20000000;
+    try {
+        LevelSimulation simulation{ LevelData(level) };
+        Recorder recorder;
+        simulation.getWorld().SetContactListener(&recorder);
+        simulation.launch(0, LevelSimulation::impulseFromOffset(sf::Vector2f(-90, 20)));
+        simulation.step(600);
+        if (recorder.pairs.empty()) {
+            std::cerr << "The shot made no contacts!" << std::endl;
+            return 1;
+        }
+        std::vector<std::string> tagsA, tagsB;
+        for (const Pair& pair : recorder.pairs) {
+            tagsA.push_back(tagName(pair.a));
+            tagsB.push_back(tagName(pair.b));
+        }
+
+        // both ways must agree before their speed means anything
+        for (std::size_t i = 0; i < recorder.pairs.size(); i++) {
+            const Pair& pair = recorder.pairs[i];
+            std::uint8_t legacyA, legacyB, tableA, tableB;
+            legacyRules(tagsA[i], tagsB[i], pair.dynamicA, pair.dynamicB, legacyA, legacyB);
+            tableRules(pair.a, pair.b, pair.dynamicA, pair.dynamicB, tableA, tableB);
+            if (legacyA != tableA || legacyB != tableB) {
+                std::cerr << "The rule table disagrees with the string tags for " << tagsA[i] << " vs " << tagsB[i] << "!" << std::endl;
+                return 1;
+            }
+        }
+
+        std::size_t recorded = recorder.pairs.size();
+        unsigned checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t n = 0; n < contacts; n++) {
+            std::size_t i = n % recorded;
+            const Pair& pair = recorder.pairs[i];
+            std::uint8_t ruleA, ruleB;
+            legacyRules(tagsA[i], tagsB[i], pair.dynamicA, pair.dynamicB, ruleA, ruleB);
+            checksum += ruleA + ruleB;
+        }
+        double legacy = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t n = 0; n < contacts; n++) {
+            const Pair& pair = recorder.pairs[n % recorded];
+            std::uint8_t ruleA, ruleB;
+            tableRules(pair.a, pair.b, pair.dynamicA, pair.dynamicB, ruleA, ruleB);
+            checksum -= ruleA + ruleB;
+        }
+        double table = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << recorded << " contacts recorded, " << contacts << " classified each way (checksum " << checksum << ")\n"
+                  << "string tags: " << (legacy > 0 ? contacts / legacy : 0) << " contacts/s\n"
+                  << "rule table:  " << (table > 0 ? contacts / table : 0) << " contacts/s" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
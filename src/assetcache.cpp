@@ -0,0 +1,69 @@
+#include "assetcache.hpp"
+#include <stdexcept>
+#include "tracer.hpp"
+
+std::shared_ptr<sf::Texture> AssetCache::getTexture(const std::string& path) {
+    return load(textures(), path, "texture");
+}
+
+std::shared_ptr<sf::SoundBuffer> AssetCache::getSoundBuffer(const std::string& path) {
+    return load(soundBuffers(), path, "sound");
+}
+
+const TextureAtlas& AssetCache::getAtlas() {
+    static TextureAtlas atlas;
+    static bool built = false;
+    if (!built) {
+        TRACE_ZONE("TextureAtlas::build");
+        atlas.build("../src/imagefiles");
+        built = true;
+    }
+    return atlas;
+}
+
+std::size_t AssetCache::textureCount() {
+    return count(textures());
+}
+
+std::size_t AssetCache::soundBufferCount() {
+    return count(soundBuffers());
+}
+
+template <typename Asset>
+std::shared_ptr<Asset> AssetCache::load(Cache<Asset>& cache, const std::string& path, const std::string& kind) {
+    // reuse the asset if some object still holds it
+    std::weak_ptr<Asset>& entry = cache[path];
+    if (std::shared_ptr<Asset> asset = entry.lock()) {
+        return asset;
+    }
+    // otherwise decode the file once and remember it
+    TRACE_ZONE("AssetCache::load");
+    auto asset = std::make_shared<Asset>();
+    if (!asset->loadFromFile(path)) {
+        cache.erase(path);
+        throw std::runtime_error("Error loading " + kind + " file: " + path + "!");
+    }
+    entry = asset;
+    return asset;
+}
+
+template <typename Asset>
+std::size_t AssetCache::count(Cache<Asset>& cache) {
+    std::size_t sum = 0;
+    for (const auto& entry : cache) {
+        if (!entry.second.expired()) {
+            sum++;
+        }
+    }
+    return sum;
+}
+
+AssetCache::Cache<sf::Texture>& AssetCache::textures() {
+    static Cache<sf::Texture> cache;
+    return cache;
+}
+
+AssetCache::Cache<sf::SoundBuffer>& AssetCache::soundBuffers() {
+    static Cache<sf::SoundBuffer> cache;
+    return cache;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include "textureatlas.hpp"
+
+/**
+ * @class AssetCache
+ * @brief Process-wide cache of textures and sound buffers keyed by file path.
+ *
+ * Every object of the same type uses the same image and sound file, so the cache
+ * hands out shared handles instead of letting each object decode its own copy.
+ * The cache only keeps weak references: an asset is freed when the last object
+ * using it is destroyed and loaded again the next time somebody asks for it.
+ *
+ * The cache is meant to be used from the main (rendering) thread only.
+ */
+class AssetCache {
+public:
+    /**
+     * @brief Get the texture loaded from the given file.
+     *
+     * Loads the file on the first request, later requests with the same path
+     * return the same texture as long as somebody still holds it.
+     *
+     * @param path Path to the image file.
+     * @return Shared handle to the texture.
+     * @throws std::runtime_error if the file cannot be loaded.
+     */
+    static std::shared_ptr<sf::Texture> getTexture(const std::string& path);
+
+    /**
+     * @brief Get the sound buffer loaded from the given file.
+     *
+     * @param path Path to the sound file.
+     * @return Shared handle to the sound buffer.
+     * @throws std::runtime_error if the file cannot be loaded.
+     */
+    static std::shared_ptr<sf::SoundBuffer> getSoundBuffer(const std::string& path);
+
+    /**
+     * @brief Get the atlas containing every image of the imagefiles directory.
+     *
+     * The atlas is built on the first call, which the game does at startup,
+     * and lives until the program exits.
+     *
+     * @return The shared texture atlas.
+     * @throws std::runtime_error if the atlas cannot be built.
+     */
+    static const TextureAtlas& getAtlas();
+
+    /**
+     * @brief Get the number of textures currently resident in the cache.
+     */
+    static std::size_t textureCount();
+
+    /**
+     * @brief Get the number of sound buffers currently resident in the cache.
+     */
+    static std::size_t soundBufferCount();
+
+private:
+    template <typename Asset>
+    using Cache = std::unordered_map<std::string, std::weak_ptr<Asset>>;
+
+    template <typename Asset>
+    static std::shared_ptr<Asset> load(Cache<Asset>& cache, const std::string& path, const std::string& kind);
+
+    template <typename Asset>
+    static std::size_t count(Cache<Asset>& cache);
+
+    static Cache<sf::Texture>& textures();
+    static Cache<sf::SoundBuffer>& soundBuffers();
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <vector>
+#include <box2d/box2d.h>
+#include "object.hpp"
+#include "userdata.hpp"
+
+/**
+ * @class AwakeSet
+ * @brief The objects whose drawn position may be out of date.
+ *
+ * An object joins the set when its body can move: when a contact of it begins or is solved
+ * (a sleeping body is woken by contacts only), when it is launched, and when it is moved
+ * by hand. It leaves the set once its body has fallen asleep or is disabled, after a last
+ * update. Syncing the drawn transforms then costs as much as there are moving bodies,
+ * however many bodies are resting in a settled structure.
+ *
+ * Each object knows its place in the set, so adding and removing take constant time.
+ */
+class AwakeSet {
+public:
+    /**
+     * @brief Add an object, nothing happens if it is in the set already.
+     */
+    void add(Object* object) {
+        if (object->getAwakeIndex() < 0) {
+            object->setAwakeIndex(static_cast<int>(objects_.size()));
+            // start interpolating from where it is now, not from where it fell asleep
+            object->savePreviousTransform();
+            objects_.push_back(object);
+        }
+    }
+
+    /**
+     * @brief Remove an object, e.g. before it is deleted.
+     */
+    void remove(Object* object) {
+        int index = object->getAwakeIndex();
+        if (index >= 0) {
+            objects_[index] = objects_.back();
+            objects_[index]->setAwakeIndex(index);
+            objects_.pop_back();
+            object->setAwakeIndex(-1);
+        }
+    }
+
+    /**
+     * @brief Remove every object.
+     */
+    void clear() {
+        for (Object* object : objects_) {
+            object->setAwakeIndex(-1);
+        }
+        objects_.clear();
+    }
+
+    /**
+     * @brief Save the transforms of the objects before a physics step, for interpolation.
+     */
+    void savePreviousTransforms() {
+        for (Object* object : objects_) {
+            object->savePreviousTransform();
+        }
+    }
+
+    /**
+     * @brief Update the drawn transforms of the objects and drop the ones that stopped moving.
+     *
+     * @param alpha How far between the last two physics steps to draw the objects.
+     */
+    void update(float alpha) {
+        for (std::size_t i = 0; i < objects_.size();) {
+            Object* object = objects_[i];
+            const b2Body* body = object->getBody();
+            if (!body || !body->IsAwake() || !body->IsEnabled()) {
+                object->Update(1.0f);           // at rest where the body is
+                object->savePreviousTransform();    // no longer interpolated from the step before
+                remove(object);                 // the last object takes place i
+            }
+            else {
+                object->Update(alpha);
+                i++;
+            }
+        }
+    }
+
+    /**
+     * @brief Add both objects of a contact, called from contact listeners.
+     */
+    void addContact(b2Contact* contact) {
+        for (b2Body* body : { contact->GetFixtureA()->GetBody(), contact->GetFixtureB()->GetBody() }) {
+            Userdata* data = reinterpret_cast<Userdata*>(body->GetUserData().pointer);
+            if (data && data->object && body->GetType() != b2_staticBody) {
+                add(data->object);
+            }
+        }
+    }
+
+    std::size_t size() const { return objects_.size(); }
+
+    const std::vector<Object*>& getObjects() const { return objects_; }
+
+private:
+    std::vector<Object*> objects_;
+};
+
+/**
+ * @class AwakeListener
+ * @brief Contact listener that only keeps an AwakeSet up to date, for worlds without a CollisionListener.
+ */
+class AwakeListener : public b2ContactListener {
+public:
+    explicit AwakeListener(AwakeSet& set) : set_(set) {}
+
+    void BeginContact(b2Contact* contact) override { set_.addContact(contact); }
+    void PostSolve(b2Contact* contact, const b2ContactImpulse* /*impulse*/) override { set_.addContact(contact); }
+
+private:
+    AwakeSet& set_;
+};
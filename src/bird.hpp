@@ -2,7 +2,7 @@
 
 #include "object.hpp"
 #include <box2d/box2d.h>
-#include <userdata.hpp>
+#include "userdata.hpp"
 
 /**
  * @brief Parent class for all bird objects in the game.
@@ -56,14 +56,14 @@ public:
      * 
      * @return Boolean value 'true' if the special action has been used, 'false' otherwise.
      */
-    bool isSpecialActionUsed() { return special_action_used_; }
+    bool isSpecialActionUsed() const { return special_action_used_; }
 
     /**
      * @brief Check if the bird is marked as dead.
      * 
      * @return Boolean value 'true' if the bird is dead, 'false' otherwise.
      */
-    bool isDead() { return isKilled_; }
+    bool isDead() const { return isKilled_; }
 
      /**
      * @brief Mark the bird as dead.
@@ -75,7 +75,7 @@ public:
      * 
      * @return Boolean value 'true' if the bird has been shot, 'false' otherwise.
      */
-    bool isShot() { return isShot_; }
+    bool isShot() const { return isShot_; }
 
     /**
      * @brief Mark the bird as shot.
@@ -83,39 +83,21 @@ public:
     void shoot() { isShot_ = true; }
 
     /**
-     * @brief Update the bird's position and orientation.
-     * 
-     * Synchronizes the graphical representation of the bird with its physical position 
-     * in the game.
+     * @brief Save the initial state, including whether the special action is available.
      */
-    void Update() {
-        if (body_)
-        {
-            b2Vec2 position = body_->GetPosition();
-            double angle = body_->GetAngle();
-
-            setX(position.x * 100.0f);
-            setY(position.y * 100.0f);
-
-            // Convert the position from Box2D units to SFML pixels
-            sprite_.setPosition(position.x * 100.0f, position.y * 100.0f);  // Convert meters to pixels
-            sprite_.setRotation(angle * 180.0f / b2_pi);  // Convert radians to degrees
-        }
+    void saveInitialState() override {
+        Object::saveInitialState();
+        initialSpecialActionUsed_ = special_action_used_;
     }
 
     /**
-     * @brief Check if a given position is within the bounds of the bird's sprite.
-     * 
-     * @param position The pixel position to check.
-     * @param window The render window for coordinate transformation.
-     * @return Boolean value 'true' if the position is within the bird's bounds, 'false' otherwise.
+     * @brief Reset the bird back to the slingshot queue, not shot and not dead.
      */
-    bool inBounds(sf::Vector2i position, sf::RenderWindow& window) {
-        sf::Vector2f globalPosition = window.mapPixelToCoords(position);
-        sf::FloatRect bounds = getSprite().getGlobalBounds();
-        bounds.contains(globalPosition);
-        return bounds.contains(globalPosition);
-        //return bounds.contains(static_cast<sf::Vector2f>(position));  // check if clicked position inside bounds 
+    void restoreInitialState() override {
+        special_action_used_ = initialSpecialActionUsed_;
+        isKilled_ = false;
+        isShot_ = false;
+        Object::restoreInitialState();
     }
 
     /**
@@ -126,12 +108,7 @@ public:
      * @param world Reference to the Box2D world where the bird will be added.
      */
     void initializePhysicsWorld(b2World &world) {
-        Userdata* data = new Userdata;
-        data->object = this;
-        data->objecttype = "bird";
-        b2BodyUserData userdata;
-        userdata.pointer = reinterpret_cast<uintptr_t>(data);
-        bodyDef_.userData = userdata;
+        bodyDef_.userData.pointer = attachUserdata(ObjectType::Bird);
         bodyDef_.fixedRotation = true;
         body_ = world.CreateBody(&bodyDef_);
         body_->CreateFixture(&fixtureDef_);
@@ -142,4 +119,5 @@ protected:
     bool special_action_used_ = false;  // flag to see if special action has been used
     bool isKilled_ = false;             // flag to see if the bird is dead
     bool isShot_ = false;               // flag to see if the bird has been shot
+    bool initialSpecialActionUsed_ = false; // special_action_used_ when the level was built
 };
\ No newline at end of file
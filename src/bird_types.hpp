@@ -17,7 +17,7 @@ public:
      * soundFilePath, textureFilePath, density, friction, restitution and action_used.
      * The attributes described more specific in bird.hpp.
      */
-    YellowBird (double x, double y) : Bird (300, x, y, 20, 20, "../src/soundfiles/yellowbird.wav", "../src/imagefiles/yellowbird.png", 1, 1, 0.1, false) {}
+    YellowBird (double x, double y) : Bird (300, x, y, 20, 20, "../src/soundfiles/yellowbird.wav", "../src/imagefiles/yellowbird.png", 1, 1, 0.1, false) { material_ = Material::Yellow; }
     
     /**
      * @brief Destructor for the YellowBird.
@@ -55,7 +55,7 @@ public:
      * soundFilePath, textureFilePath, density, friction, restitution and action_used.
      * The attributes described more specific in bird.hpp.
      */
-    RedBird (double x, double y) : Bird (150, x, y, 30, 30, "../src/soundfiles/redbird.wav", "../src/imagefiles/redbird.png", 1, 1, 0.1, true) {}
+    RedBird (double x, double y) : Bird (150, x, y, 30, 30, "../src/soundfiles/redbird.wav", "../src/imagefiles/redbird.png", 1, 1, 0.1, true) { material_ = Material::Red; }
     
     /**
      * @brief Destructor for the RedBird.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include "profiler.hpp"
 
 /**
  * @class Button
@@ -213,6 +214,7 @@ public:
         else {
             window.draw(text_);
         }
+        PROFILE_COUNT(ProfileCounter::DrawCalls, 2);
     }
 
     /**
@@ -1,49 +1,122 @@
 #pragma once
 
 #include <box2d/box2d.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iostream>
+#include <vector>
 #include "object.hpp"
 #include "userdata.hpp"
+#include "materials.hpp"
+#include "awakeset.hpp"
+#include "tracer.hpp"
 
 
 
+/**
+ * @brief An object that made a sound and how hard it was hit
+ * 
+ */
+struct SoundEvent {
+    Object* object;
+    float strength;     // relative speed of the two bodies in m/s
+};
+
 /**
  * @brief The Box2D (physics) world calls this class when two things collide
  * Manages taking damage
+ * Damage comes from the normal impulses of the contacts, summed per object over a physics step
+ * and applied by step() through the material table
+ * Only impacts count: PreSolve() marks the contacts whose bodies close faster than kImpactSpeed,
+ * so the weight of a resting stack does no harm however tall it is
+ * Time is counted in simulated seconds given to step(), so the listener works the same
+ * with or without a window
  * 
  */
 
 class CollisionListener : public b2ContactListener {
     public:
         /**
-         * @brief default constructor so that a default CollisionListener can be initialized in LevelState
+         * @brief What happens to an object in a contact, flags of the rule table
+         * 
+         */
+        enum Rule : std::uint8_t {
+            Speak = 1 << 0,         // plays its sound
+            Land = 1 << 1,          // stops flying and starts to rotate
+            Damage = 1 << 2,        // takes impulse damage if its body is dynamic
+            Collect = 1 << 3,       // destroyed by any touch, for sensors that get no impulses
+            Score = 1 << 4          // the damage from the contact is added to the score
+        };
+
+        static constexpr float kImpactSpeed = 0.5f;    // m/s along the normal, slower contacts are at rest
+
+        static constexpr std::size_t kTypeCount = static_cast<std::size_t>(ObjectType::Count);
+        using RuleTable = std::array<std::array<std::uint8_t, kTypeCount>, kTypeCount>;
+
+        /**
+         * @brief Get the rule table, built on the first call
+         * 
+         * rules()[a][b] tells what happens to an object of type a when it hits an object of type b.
+         */
+        static const RuleTable& rules() {
+            static const RuleTable table = makeRules();
+            return table;
+        }
+
+        /**
+         * @brief default constructor so that a default CollisionListener can be initialized in LevelSimulation
          * 
          */
         CollisionListener() {};
+
+        /**
+         * @brief Report the objects of every begun or solved contact to an awake set
+         * 
+         */
+        void setAwakeSet(AwakeSet* awake) {
+            awake_ = awake;
+        }
+
+        /**
+         * @brief Use a material table for impulse damage, without one no impulse damage is taken
+         * 
+         */
+        void setMaterials(const Materials* materials) {
+            materials_ = materials;
+        }
+
         /**
-         * @brief constructor with a clock to track time from the creation of the world
+         * @brief Called after a physics step: apply the damage of the step and advance the time of the listener
          * 
-         * @param clockForWorld clock to track time
+         * @param timeStep length of the step in seconds
          */
-        CollisionListener(sf::Clock& clockForWorld) : clockForWorld_(clockForWorld) {} 
+        void step(float timeStep) {
+            applyLoads();
+            impacts_.clear();
+            if (contactCount_ > 0) {
+                elapsedTime_ += timeStep;
+            }
+        }
 
 
         /**
          * @brief Called when two fixtures start to collide
-         * Manage taking damage
+         * Play sounds, land birds and collect the star
          * Marking which bodies to remove from the physics world
-         * Increase the player's score
          * 
          */
         void BeginContact(b2Contact* contact) override {
+            TRACE_ZONE("CollisionListener::BeginContact");
             if (contactCount_ == 0)
             {
                 // std::cout << "nyt" << std::endl;
-                clockForWorld_.restart(); // kello alkaa kulkea ensimmäisestä törmäyksestä
+                elapsedTime_ = 0; // kello alkaa kulkea ensimmäisestä törmäyksestä
             }
             
             contactCount_++;
-            float elapsedTime = clockForWorld_.getElapsedTime().asSeconds();
+            if (awake_) { awake_->addContact(contact); }
+            float elapsedTime = elapsedTime_;
             // Retrieve the two fixtures involved in the collision
             b2Fixture* fixtureA = contact->GetFixtureA();
             b2Fixture* fixtureB = contact->GetFixtureB();
@@ -62,102 +135,267 @@ class CollisionListener : public b2ContactListener {
                 // std::cout << "time: " << elapsedTime << std::endl;
                 dataA->object->incrementSpeak();
                 dataB->object->incrementSpeak();
-                // std::cout << "Collision between " << dataA->objecttype << " and " << dataB->objecttype << std::endl;
-                // Ground does not speak dataA->objecttype != "ground" && dataB->objecttype != "ground"
-            
+                // what happens to each object depends only on the two types, see makeRules()
+                const RuleTable& table = rules();
+                std::uint8_t ruleA = table[static_cast<std::size_t>(dataA->type)][static_cast<std::size_t>(dataB->type)];
+                std::uint8_t ruleB = table[static_cast<std::size_t>(dataB->type)][static_cast<std::size_t>(dataA->type)];
 
-                if (dataA->objecttype != "ground")
-                {
-                    // std::cout << dataA->objecttype << " speaks" << std::endl;
-                    dataA->object->speak();
-                }
-                if (dataB->objecttype != "ground")
-                {
-                    // std::cout << dataB->objecttype << " speaks" << std::endl;
-                    dataB->object->speak();
-                }
+                float strength = (bodyA->GetLinearVelocity() - bodyB->GetLinearVelocity()).Length();
+                if (ruleA & Speak) { speakers_.push_back(SoundEvent{ dataA->object, strength }); }
+                if (ruleB & Speak) { speakers_.push_back(SoundEvent{ dataB->object, strength }); }
                 // Birds do not rotate before impact. Makes them rotate after impact
-                if (dataA->objecttype == "bird")
+                if ((ruleA & Land) && dataA->object->isFlying())
                 {
-                    if (dataA->object->isFlying())
-                    {
-                        dataA->object->land();
-                        dataA->object->resetFixedRotation();
-                    }
+                    dataA->object->land();
+                    dataA->object->resetFixedRotation();
                 }
-                if (dataB->objecttype == "bird")
+                if ((ruleB & Land) && dataB->object->isFlying())
                 {
-                    if (dataB->object->isFlying())
-                    {
-                        dataB->object->land();
-                        dataB->object->resetFixedRotation();
-                    }
+                    dataB->object->land();
+                    dataB->object->resetFixedRotation();
                 }
                 
-                // Damage based on the kinectic energy of both objects
-                double keA = 0.5 * dataA->object->getBody()->GetMass() * dataA->object->getSpeed() * dataA->object->getSpeed();
-                double keB = 0.5 * dataB->object->getBody()->GetMass() * dataB->object->getSpeed() * dataB->object->getSpeed();
-                double dmgDealt = 20 * (keA + keB);
-                if (dataA->objecttype != "ground" && (bodyA->GetType() == b2_dynamicBody || dataA->objecttype == "star")) // ground doesn't take damage
+                // the star is a sensor, it is collected by touching it
+                if (ruleA & Collect)
                 {
-                    dataA->object->takeDamage(dmgDealt);
-                    // std::cout << dataA->objecttype << " hp: " << dataA->object->getHp() << std::endl;                 
+                    dataA->object->takeDamage(dataA->object->getHp());
+                    queueRemoval(*dataA);
                 }
-                if (dataB->objecttype != "ground" && (bodyB->GetType() == b2_dynamicBody || dataB->objecttype == "star"))
+                if (ruleB & Collect)
                 {
-                    dataB->object->takeDamage(dmgDealt);
-                    // std::cout << dataB->objecttype << " hp: " << dataB->object->getHp() << std::endl;  
-                }
-
-                // increase score when hitting obstacles 
-                if ((dataA->objecttype == "obstacle" && dataB->objecttype == "bird") || (dataB->objecttype == "obstacle" && dataA->objecttype == "bird")) {
-                    score_ += dmgDealt * 10;
-                    // std::cout << "score is now " << score_ << std::endl;
+                    dataB->object->takeDamage(dataB->object->getHp());
+                    queueRemoval(*dataB);
                 }
+            }
+        }
 
-                // If hp of an object drops to zero they will be added to a list of bodies to remove from the b2World
-                // Removing is done in the game loop
-                if (dataA->object->getHp() <= 0)
-                {
-                    if (std::find(removedBodies_.begin(), removedBodies_.end(), dataA->object->getBody()) == removedBodies_.end()) //check if the b2Body has already been removed
-                    {
-                        bodiesToRemove_.push_back(dataA->object->getBody()); // add the b2Body to a vector of bodies that should be deleted
-                        removedBodies_.push_back(dataA->object->getBody()); // add the b2Body to a vector of deleted bodies
-                    }
-                }
-                if (dataB->object->getHp() <= 0)
+        /**
+         * @brief Called before the solver for each touching contact
+         * Remember the contact as an impact if its bodies close faster than kImpactSpeed at one of its points
+         * 
+         */
+        void PreSolve(b2Contact* contact, const b2Manifold* /*oldManifold*/) override {
+            if (!materials_ || elapsedTime_ <= 0.5f)
+            {
+                return;
+            }
+            b2Body* bodyA = contact->GetFixtureA()->GetBody();
+            b2Body* bodyB = contact->GetFixtureB()->GetBody();
+            b2WorldManifold manifold;
+            contact->GetWorldManifold(&manifold);
+            for (int i = 0; i < contact->GetManifold()->pointCount; i++)
+            {
+                // the normal points from A to B
+                b2Vec2 relative = bodyA->GetLinearVelocityFromWorldPoint(manifold.points[i])
+                                - bodyB->GetLinearVelocityFromWorldPoint(manifold.points[i]);
+                if (b2Dot(relative, manifold.normal) >= kImpactSpeed)
                 {
-                    if (std::find(removedBodies_.begin(), removedBodies_.end(), dataB->object->getBody()) == removedBodies_.end()) //check if the b2Body has already been removed
-                    {
-                        bodiesToRemove_.push_back(dataB->object->getBody()); // add the b2Body to a vector of bodies that should be deleted
-                        removedBodies_.push_back(dataB->object->getBody()); // add the b2Body to a vector of deleted bodies
-                    }
+                    impacts_.push_back(contact);
+                    return;
                 }
             }
         }
 
         /**
-         * @brief Get the bodies to remove from the physics world
+         * @brief Called after the solver for each touching contact
+         * Add the normal impulse of an impact to the load of both objects, step() turns the loads into damage
+         * A bird's material multiplies the impulse it deals
          * 
          */
+        void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override {
+            TRACE_ZONE("CollisionListener::PostSolve");
+            if (awake_) { awake_->addContact(contact); } // bodies woken through their island only show up here
+            if (!materials_ || elapsedTime_ <= 0.5f) // check that the game started at least 0.5 second ago
+            {
+                return;
+            }
+            b2Body* bodyA = contact->GetFixtureA()->GetBody();
+            b2Body* bodyB = contact->GetFixtureB()->GetBody();
+            Userdata* dataA = reinterpret_cast<Userdata*>(bodyA->GetUserData().pointer);
+            Userdata* dataB = reinterpret_cast<Userdata*>(bodyB->GetUserData().pointer);
+            if (!dataA->object || !dataB->object)
+            {
+                return;
+            }
+            if (std::find(impacts_.begin(), impacts_.end(), contact) == impacts_.end()) // resting contacts do no damage
+            {
+                return;
+            }
+            float total = 0;
+            for (int i = 0; i < impulse->count; i++)
+            {
+                total += impulse->normalImpulses[i];
+            }
+            if (total <= 0)
+            {
+                return;
+            }
+            const RuleTable& table = rules();
+            std::uint8_t ruleA = table[static_cast<std::size_t>(dataA->type)][static_cast<std::size_t>(dataB->type)];
+            std::uint8_t ruleB = table[static_cast<std::size_t>(dataB->type)][static_cast<std::size_t>(dataA->type)];
+            if ((ruleA & Damage) && bodyA->GetType() == b2_dynamicBody)
+            {
+                addLoad(*dataA, total * (*materials_)[dataB->object->getMaterial()].multiplier, ruleA & Score);
+            }
+            if ((ruleB & Damage) && bodyB->GetType() == b2_dynamicBody)
+            {
+                addLoad(*dataB, total * (*materials_)[dataA->object->getMaterial()].multiplier, ruleB & Score);
+            }
+        }
 
-        const std::vector<b2Body*>& getBodiesToRemove() const {
-            return bodiesToRemove_;
+        /**
+         * @brief Get the objects to remove from the physics world, each at most once
+         * 
+         */
+        const std::vector<ObjectHandle>& getRemovalQueue() const {
+            return removalQueue_;
         }
 
-        // Clear the list of bodies to remove after they are destroyed
-        void clearBodiesToRemove() {
-            bodiesToRemove_.clear();
+        // Clear the queue after the objects are removed
+        void clearRemovalQueue() {
+            removalQueue_.clear();
         }
 
-        int getScore() {
+        int getScore() const {
             return score_;
         }
 
+        /**
+         * @brief Get the objects that were hit and should play their sound
+         * 
+         */
+        const std::vector<SoundEvent>& getSpeakers() const {
+            return speakers_;
+        }
+
+        // Clear the list of speakers after the sounds are played
+        void clearSpeakers() {
+            speakers_.clear();
+        }
+
+        /**
+         * @brief Forget all collisions, used when the level is restarted in place
+         * 
+         */
+        void reset() {
+            for (const Load& load : loads_) {
+                loadSlots_[load.data->handle.index] = kNoLoad;
+            }
+            loads_.clear();
+            impacts_.clear();
+            removalQueue_.clear();
+            speakers_.clear();
+            contactCount_ = 0;
+            elapsedTime_ = 0;
+            score_ = 0;
+        }
+
     private:
-        std::vector<b2Body*> removedBodies_;
-        std::vector<b2Body*> bodiesToRemove_;
-        sf::Clock clockForWorld_;
+        /**
+         * @brief Impulse taken by one object during the current step
+         * 
+         */
+        struct Load {
+            Userdata* data;
+            float impulse;      // sum of the normal impulses in N*s
+            float scored;       // part of impulse from contacts that score
+        };
+
+        static constexpr std::uint32_t kNoLoad = ObjectHandle::kInvalid;
+
+        /**
+         * @brief Add impulse to the load of an object, loads are kept in a compact array indexed through the object's handle
+         * 
+         */
+        void addLoad(Userdata& data, float impulse, bool scored) {
+            std::uint32_t index = data.handle.index;
+            if (index == ObjectHandle::kInvalid) // objects without a handle are not tracked
+            {
+                return;
+            }
+            if (index >= loadSlots_.size())
+            {
+                loadSlots_.resize(index + 1, kNoLoad);
+            }
+            if (loadSlots_[index] == kNoLoad)
+            {
+                loadSlots_[index] = static_cast<std::uint32_t>(loads_.size());
+                loads_.push_back(Load{ &data, 0, 0 });
+            }
+            Load& load = loads_[loadSlots_[index]];
+            load.impulse += impulse;
+            if (scored)
+            {
+                load.scored += impulse;
+            }
+        }
+
+        /**
+         * @brief Damage every object that took more impulse during the step than its material resists
+         * 
+         */
+        void applyLoads() {
+            for (const Load& load : loads_) {
+                Object* object = load.data->object;
+                const MaterialProperties& material = (*materials_)[object->getMaterial()];
+                float excess = load.impulse - material.resistance;
+                if (excess > 0 && !object->isPendingRemoval())
+                {
+                    int damage = static_cast<int>(excess * material.damage + 0.5f);
+                    object->takeDamage(damage);
+                    // increase score when birds damage obstacles
+                    score_ += static_cast<int>(10 * damage * load.scored / load.impulse);
+                    // std::cout << "hp: " << object->getHp() << std::endl;
+                    queueRemoval(*load.data);
+                }
+                loadSlots_[load.data->handle.index] = kNoLoad;
+            }
+            loads_.clear();
+        }
+
+        /**
+         * @brief If hp of an object dropped to zero it is queued for removal from the b2World
+         * Removing is done after the step, the pending flag keeps an object from being queued twice
+         * 
+         */
+        void queueRemoval(Userdata& data) {
+            if (data.object->getHp() <= 0 && data.object->markForRemoval())
+            {
+                removalQueue_.push_back(data.handle);
+            }
+        }
+
+        /**
+         * @brief Fill the rule table, a new object type needs its row here
+         * 
+         */
+        static RuleTable makeRules() {
+            RuleTable table{};
+            auto row = [&table](ObjectType type, std::uint8_t rule) {
+                table[static_cast<std::size_t>(type)].fill(rule);
+            };
+            auto pair = [&table](ObjectType type, ObjectType other, std::uint8_t rule) {
+                table[static_cast<std::size_t>(type)][static_cast<std::size_t>(other)] |= rule;
+            };
+            // what happens to an object whatever it hits
+            row(ObjectType::Bird, Speak | Land | Damage);
+            row(ObjectType::Pig, Speak | Damage);
+            row(ObjectType::Obstacle, Speak | Damage);
+            row(ObjectType::Star, Speak | Collect);
+            row(ObjectType::Ground, 0);             // ground does not speak or take damage
+            // what depends on the other object too
+            pair(ObjectType::Obstacle, ObjectType::Bird, Score);
+            return table;
+        }
+
+        const Materials* materials_ = nullptr;
+        AwakeSet* awake_ = nullptr;
+        std::vector<Load> loads_;                   // objects loaded during the current step
+        std::vector<std::uint32_t> loadSlots_;      // position in loads_ by handle index, kNoLoad if none
+        std::vector<b2Contact*> impacts_;           // contacts closing faster than kImpactSpeed in the current step
+        std::vector<ObjectHandle> removalQueue_;
+        std::vector<SoundEvent> speakers_;
+        float elapsedTime_ = 0;        // simulated seconds since the first contact
         int contactCount_ = 0;
         int score_ = 0;
 };
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * @class FixedStepScheduler
+ * @brief Turns the frame time into a number of fixed physics steps.
+ *
+ * Elapsed time is accumulated and consumed in steps of a fixed length, so the physics
+ * advance the same way regardless of the frame rate. At most maxSteps steps are run per
+ * frame: after a hitch, such as a long level load or dragging the window, the excess
+ * time is dropped instead of being caught up with hundreds of steps. The remainder
+ * below one step is kept and given as the interpolation factor for drawing.
+ */
+class FixedStepScheduler {
+public:
+    /**
+     * @brief Construct a scheduler.
+     *
+     * @param timeStep Length of one step in seconds.
+     * @param maxSteps Largest number of steps run for one frame.
+     */
+    FixedStepScheduler(double timeStep = 1.0 / 60.0, int maxSteps = 5) : timeStep_(timeStep), maxSteps_(maxSteps) {}
+
+    /**
+     * @brief Add the time of a frame and get the number of steps to run for it.
+     *
+     * @param seconds Elapsed time since the previous frame.
+     * @return Number of steps to run, at most maxSteps.
+     */
+    int advance(double seconds) {
+        accumulator_ += seconds;
+        int steps = static_cast<int>(accumulator_ / timeStep_);
+        int dropped = 0;
+        if (steps > maxSteps_) {
+            dropped = steps - maxSteps_;
+            steps = maxSteps_;
+        }
+        accumulator_ -= (steps + dropped) * timeStep_;
+        lastSteps_ = steps;
+        lastDropped_ = dropped;
+        totalSteps_ += steps;
+        totalDropped_ += dropped;
+        return steps;
+    }
+
+    /**
+     * @brief Forget the accumulated time and the counters.
+     */
+    void reset() {
+        accumulator_ = 0;
+        lastSteps_ = 0;
+        lastDropped_ = 0;
+        totalSteps_ = 0;
+        totalDropped_ = 0;
+    }
+
+    /**
+     * @brief Get how far the time is between the last two steps, from 0 to 1.
+     *
+     * Drawing objects at previous + alpha * (current - previous) keeps motion smooth when
+     * the frame rate differs from the step rate.
+     */
+    float getAlpha() const { return static_cast<float>(accumulator_ / timeStep_); }
+
+    double getTimeStep() const { return timeStep_; }
+    int getMaxSteps() const { return maxSteps_; }
+
+    /**
+     * @brief Number of steps run for the last frame.
+     */
+    int getLastSteps() const { return lastSteps_; }
+
+    /**
+     * @brief Number of steps dropped for the last frame because of the cap.
+     */
+    int getLastDropped() const { return lastDropped_; }
+
+    /**
+     * @brief Number of steps run since the scheduler was created or reset.
+     */
+    long long getTotalSteps() const { return totalSteps_; }
+
+    /**
+     * @brief Number of steps dropped since the scheduler was created or reset.
+     */
+    long long getTotalDropped() const { return totalDropped_; }
+
+private:
+    double timeStep_;
+    int maxSteps_;
+    double accumulator_ = 0;        // time not simulated yet, less than one step after advance()
+    int lastSteps_ = 0;
+    int lastDropped_ = 0;
+    long long totalSteps_ = 0;
+    long long totalDropped_ = 0;
+};
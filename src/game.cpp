@@ -1,10 +1,12 @@
 #include "game.hpp"
 #include <box2d/box2d.h>
+#include <iostream>
 
 
 Game::Game() 
     : window_(sf::VideoMode(1366, 768), "Angry Birds game", sf::Style::Titlebar | sf::Style::Close) {
         window_.setView(view_);
+        window_.setFramerateLimit(kFrameRateLimit);     // every state, the settling of a level included, runs at this rate
         pushState(std::make_unique<NameState>());
 }
 
@@ -20,67 +22,100 @@ void Game::run() {
     sf::Event event;
     while (window_.isOpen()){
         sf::Time deltaTime = clock.restart();
-        while (window_.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                window_.close();
-                break;
-            }
-            // as long as there is at least menu state in stack
-            else if (!states_.empty()) {
-                std::pair<std::string, int> action = states_.top()->processEvent(event, window_, view_);
-                // if level button pressed in main menu
-                if (action.first == "open") {
-                    // std::cout << "opening level" << std::endl;
-                    resetZoom(window_, view_, currentZoom_);
-                    if (dynamic_cast<MenuState*>(states_.top().get())) // to check if this action is from menustate or sandboxstate
-                    {
-                        pushState(std::make_unique<LevelState>(action.second));
+        TRACE_ZONE("frame");
+        PROFILE_FRAME_BEGIN();
+        {
+            PROFILE_SCOPE(ProfileSection::Events);
+            while (window_.pollEvent(event)) {
+                if (event.type == sf::Event::Closed) {
+                    window_.close();
+                    break;
+                }
+#ifdef ANGRY_BIRDS_PROFILER
+                else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+                    Profiler::get().setShown(!Profiler::get().isShown());
+                }
+#endif
+                // as long as there is at least menu state in stack
+                else if (!states_.empty()) {
+                    std::pair<std::string, int> action = states_.top()->processEvent(event, window_, view_);
+                    // if level button pressed in main menu
+                    if (action.first == "open") {
+                        TRACE_ZONE("open level");
+                        // std::cout << "opening level" << std::endl;
+                        resetZoom(window_, view_, currentZoom_);
+                        if (dynamic_cast<MenuState*>(states_.top().get())) // to check if this action is from menustate or sandboxstate
+                        {
+                            pushState(std::make_unique<LevelState>(action.second));
+                        }
+                        else
+                        {
+                            changeState(std::make_unique<LevelState>(action.second));
+                        }
+                    
                     }
-                    else
-                    {
+                    // if menu button pressed in a level or gameover screen
+                    else if (action.first == "menu") {
+                        TRACE_ZONE("back to menu");
+                        // std::cout << "going back to main menu" << std::endl;
+                        resetZoom(window_, view_, currentZoom_);
+                        popState();
+                    }
+                    // if restart button pressed 
+                    else if (action.first == "restart" || action.first == "next") {
+                        TRACE_ZONE("restart level");
+                        // std::cout << "opening another level" << std::endl;
+                        resetZoom(window_, view_, currentZoom_);
                         changeState(std::make_unique<LevelState>(action.second));
                     }
-                    
-                }
-                // if menu button pressed in a level or gameover screen
-                else if (action.first == "menu") {
-                    // std::cout << "going back to main menu" << std::endl;
-                    resetZoom(window_, view_, currentZoom_);
-                    popState();
-                }
-                // if restart button pressed 
-                else if (action.first == "restart" || action.first == "next") {
-                    // std::cout << "opening another level" << std::endl;
-                    resetZoom(window_, view_, currentZoom_);
-                    changeState(std::make_unique<LevelState>(action.second));
-                }
-                else if (action.first == "savename") {
-                    player_name_ = states_.top()->getPlayerName();
-                    // std::cout << "saving player name " + player_name_ << std::endl;
-                    changeState(std::make_unique<MenuState>());
-                }
-                else if (action.first == "sandbox")
-                {
-                    // std::cout << "opening sandbox" << std::endl;
-                    if (dynamic_cast<MenuState*>(states_.top().get())) // check if the action comes from menustate or opened sandbox levelstate
-                    {
-                        pushState(std::make_unique<SandboxState>());
+                    else if (action.first == "savename") {
+                        TRACE_ZONE("save name");
+                        player_name_ = states_.top()->getPlayerName();
+                        // std::cout << "saving player name " + player_name_ << std::endl;
+                        changeState(std::make_unique<MenuState>());
                     }
-                    else
+                    else if (action.first == "sandbox")
                     {
-                        changeState(std::make_unique<SandboxState>());
+                        TRACE_ZONE("open sandbox");
+                        // std::cout << "opening sandbox" << std::endl;
+                        if (dynamic_cast<MenuState*>(states_.top().get())) // check if the action comes from menustate or opened sandbox levelstate
+                        {
+                            pushState(std::make_unique<SandboxState>());
+                        }
+                        else
+                        {
+                            changeState(std::make_unique<SandboxState>());
+                        }
                     }
                 }
             }
         }
         // Update the current game state
         if (!states_.empty()) {
-            std::pair<std::string, int> action = states_.top()->update(deltaTime, window_, view_);
-            states_.top()->render(window_, view_);
+            std::pair<std::string, int> action;
+            {
+                PROFILE_SCOPE(ProfileSection::Update);
+                action = states_.top()->update(deltaTime, window_, view_);
+            }
+            {
+                PROFILE_SCOPE(ProfileSection::Render);
+                states_.top()->render(window_, view_);
+#ifdef ANGRY_BIRDS_PROFILER
+                if (Profiler::get().isShown()) {
+                    profilerOverlay_.draw(window_, Profiler::get());
+                }
+#endif
+            }
+            {
+                // waits for the frame rate limit too
+                PROFILE_SCOPE(ProfileSection::Display);
+                window_.display();
+            }
             // Checks if game is won or lost or ongoing
             if (states_.top()->isLevelState())
             {
                 if (action.first == "win") {
+                    TRACE_ZONE("level won");
                     // std::cout << "game over opening high scores" << std::endl;
                     resetZoom(window_, view_, currentZoom_);
                     int score = states_.top()->calculateScore();
@@ -88,6 +123,7 @@ void Game::run() {
                     changeState(std::make_unique<GameOverState>(action.second, true, score, player_name_, stars));
                 }
                 else if (action.first == "lose") {
+                    TRACE_ZONE("level lost");
                     // std::cout << "game over opening lose screen" << std::endl;
                     resetZoom(window_, view_, currentZoom_);
                     int score = states_.top()->calculateScore();
@@ -95,5 +131,14 @@ void Game::run() {
                 }
             }
         }
+        PROFILE_FRAME_END();
+    }
+#ifdef ANGRY_BIRDS_PROFILER
+    try {
+        Tracer::get().write();
+    }
+    catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
     }
+#endif
 }
@@ -14,6 +14,10 @@
 #include "sandboxstate.hpp"
 #include "render.hpp"
 #include "collisiondetection.hpp"
+#include "profiler.hpp"
+#ifdef ANGRY_BIRDS_PROFILER
+#include "profileroverlay.hpp"
+#endif
 
 /**
  * @class Game
@@ -24,6 +28,7 @@
 
 class Game {
 public:
+    static constexpr unsigned kFrameRateLimit = 60;     // frames per second, the physics steps at this rate too
 
     /**
      * @brief Constructs a new Game object based on information saved on file.
@@ -39,12 +44,41 @@ public:
      */
     void run();
 
+    /**
+     * @brief Write the profile of every frame to a CSV file, see Profiler::openCsv().
+     * 
+     * Does nothing if the game is built without ANGRY_BIRDS_PROFILER.
+     * @param path The file to write.
+     */
+    void profileToCsv(const std::string& path) {
+#ifdef ANGRY_BIRDS_PROFILER
+        Profiler::get().openCsv(path);
+#else
+        (void)path;
+#endif
+    }
+
+    /**
+     * @brief Record a timeline of the game, written to a Chrome trace JSON file when run() returns.
+     * 
+     * Does nothing if the game is built without ANGRY_BIRDS_PROFILER.
+     * @param path The file to write.
+     */
+    void traceToFile(const std::string& path) {
+#ifdef ANGRY_BIRDS_PROFILER
+        Tracer::get().start(path);
+#else
+        (void)path;
+#endif
+    }
+
     /**
      * @brief Push new state on state stack.
      * 
      * @param state State to be pushed.
      */
     void pushState(std::unique_ptr<GameState> state) {
+        TRACE_ZONE("Game::pushState");
         if (!states_.empty()) {
             states_.top()->stopMusic();
         }
@@ -57,6 +91,7 @@ public:
      * 
      */
     void popState() {
+        TRACE_ZONE("Game::popState");  // the popped state is destroyed here
         if (!states_.empty()) {
             states_.top()->stopMusic();
             states_.pop();
@@ -84,4 +119,7 @@ private:
     sf::View view_ = sf::View(sf::FloatRect(0, 0, 1366, 768));
     int currentZoom_ = 0;
     std::string player_name_;
+#ifdef ANGRY_BIRDS_PROFILER
+    ProfilerOverlay profilerOverlay_;   // shown with F3
+#endif
 };
@@ -131,7 +131,6 @@ public:
         for (auto button : buttons_) {
             render_.renderButton(window, *button);
         }
-        window.display();
     }
 
 private:
@@ -57,7 +57,7 @@ public:
     /**
      * @brief Render the game state.
      * 
-     * Draws the current state to the window.
+     * Draws the current state to the window, Game::run() displays it.
      * 
      * @param window The SFML render window.
      * @param view The current view of the game.
@@ -17,10 +17,13 @@ public:
      * Initializes the Ground with specific attributes: initialHp, x-coordinate, y-coordinate, width, height,
      * soundFilePath, textureFilePath, density, friction and restitution.
      * The attributes described more specific in obstacle.hpp.
+     * 
+     * @param width Width of the ground in pixels, it starts just left of the window and reaches to the right end of the level.
      */
-    Ground () : Obstacle (9999, 680, 700, 1385, 210, "../src/soundfiles/ground.wav", "../src/imagefiles/ground.png", 0, 1, 0) {
+    explicit Ground (double width = 1385) : Obstacle (9999, width / 2 - 12.5, 700, width, 210, "../src/soundfiles/ground.wav", "../src/imagefiles/ground.png", 0, 1, 0) {
         setStatic();
         setShapeRectangle();
+        material_ = Material::Ground;
     }
 
     /**
@@ -28,15 +31,22 @@ public:
      */
     ~Ground () {}
 
+    /**
+     * @brief The ground does not move, it stays drawn where it was created.
+     * 
+     * Its body sits 5 pixels lower, see moveBodyDown().
+     */
+    void Update(float /*alpha*/ = 1.0f) override {}
+
     /**
      * @brief Sets user data specific to the ground object.
      * 
-     * Updates the Box2D user data pointer with information identifying the object type as "ground".
+     * Updates the Box2D user data pointer with information identifying the object type as ObjectType::Ground.
      */
     void setData() {
         auto* userdata = reinterpret_cast<Userdata*>(getBody()->GetUserData().pointer);
         if (userdata) {
-            userdata->objecttype = "ground";
+            userdata->type = ObjectType::Ground;
         }
     }
 
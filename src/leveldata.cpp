@@ -1,117 +1,133 @@
 #include "leveldata.hpp"
+#include <algorithm>
+#include <filesystem>
 #include <memory>
+#include "tracer.hpp"
 
-void LevelData::loadFromFile(int number) {
-    std::string filepath("../src/textfiles/level" + std::to_string(number) + ".txt");
-    if (number == 4) {
-        filepath = "../src/textfiles/sandboxlevel.txt";
+namespace {
+    // pool space of one object and the control block of its shared pointer
+    constexpr std::size_t kObjectBytes = std::max({ sizeof(RedBird), sizeof(YellowBird), sizeof(KingPig), sizeof(NormalPig),
+        sizeof(WoodObstacle), sizeof(StoneObstacle), sizeof(GlassObstacle), sizeof(Star), sizeof(Ground) }) + 64;
+}
+
+void LevelData::loadFromFile(const std::string& filepath) {
+    TRACE_ZONE("LevelData::loadFromFile");
+    // compiled levels are always read as they are
+    if (LevelFile::isCompiledPath(filepath)) {
+        loadCompiled(filepath);
+        return;
+    }
+
+    // use the compiled copy of a text level if it is not older than the text
+    std::string compiled = LevelFile::compiledPath(filepath);
+    std::error_code error;
+    auto textTime = std::filesystem::last_write_time(filepath, error);
+    if (!error) {
+        auto compiledTime = std::filesystem::last_write_time(compiled, error);
+        if (!error && compiledTime >= textTime) {
+            try {
+                loadCompiled(compiled);
+                return;
+            }
+            catch (const std::runtime_error& e) {
+                // corrupted or outdated cache, fall back to the text file
+                birds_.clear();
+                pigs_.clear();
+                obstacles_.clear();
+                star_ = nullptr;
+            }
+        }
+    }
+
+    // parse the text and cache the result for the next load, e.g. a restart
+    std::vector<LevelRecord> records = LevelFile::parseText(filepath);
+    float right = 0;
+    for (const LevelRecord& record : records) {
+        right = std::max(right, record.x);
+    }
+    beginLevel(records.size(), right);
+    int birdcount = 0;
+    for (const LevelRecord& record : records) {
+        addRecord(record, birdcount);
+    }
+    try {
+        LevelFile::writeBinary(compiled, records);
+    }
+    catch (const std::runtime_error& e) {
+        std::cerr << "Could not cache compiled level: " << e.what() << std::endl;
+    }
+}
+
+void LevelData::loadCompiled(const std::string& filepath) {
+    LevelFile file(filepath);
+    float right = 0;
+    for (std::size_t i = 0; i < file.size(); ++i) {
+        right = std::max(right, file.record(i).x);
+    }
+    beginLevel(file.size(), right);
+    int birdcount = 0;
+    for (std::size_t i = 0; i < file.size(); ++i) {
+        addRecord(file.record(i), birdcount);
     }
-    std::ifstream ifs(filepath);    // file stream for reading the level file
+}
 
-    // check if file opened successfully
-    if (!ifs) {
-        throw std::runtime_error("Failed opening the file" + filepath + "!");
+void LevelData::beginLevel(std::size_t records, float right) {
+    // one block for the whole level, the ground included
+    pool_ = std::make_shared<ObjectPool>((records + 1) * kObjectBytes);
+    // levels of one screen keep the ground they always had, wider ones get a ground as wide as they are
+    width_ = kMinWidth;
+    if (right + kRightMargin > kMinWidth) {
+        width_ = right + kRightMargin;
+        ground_ = ObjectPool::make<Ground>(pool_, width_ + 12.5);
     }
-    // create ground and read information on file
     else {
-        // Create ground for the level
-        ground_ = std::make_shared<Ground>();
-        // create variables for storing lines, tokens and properties
-        std::string line;
-        std::string item;
-        std::string prop;
-        std::vector<std::string> props;
+        ground_ = ObjectPool::make<Ground>(pool_);
+    }
+}
 
-        // read each line from file stream
-        while (std::getline(ifs, line)) {    
-            // handle birds section, create and add all birds to vector
-            if (line == "Birds") {
-                int birdcount = 0;
-                while (std::getline(ifs, item) && item != "") {
-                    props.clear(); // clear props for each bird
-                    // string stream for reading pig properties from item
-                    std::istringstream iss(item);
-                    // read each property and add to vector
-                    while (std::getline(iss, prop, ' ')) {
-                        props.push_back(prop);
-                    }
-                    // add new bird to birds_ based on type
-                    if (props[0] == "Red") {
-                        std::shared_ptr<RedBird> bird = std::make_shared<RedBird>(40 * birdcount + 130, 585);
-                        birds_.push_back(bird);
-                    }
-                    else if (props[0] == "Yellow") {
-                        std::shared_ptr<YellowBird> bird = std::make_shared<YellowBird>(40 * birdcount + 130, 590);
-                        birds_.push_back(bird);
-                    }
-                    else { throw std::runtime_error("Corrupted game file at Birds!"); }
-                    birdcount++;
-                }
+void LevelData::addRecord(const LevelRecord& record, int& birdcount) {
+    switch (record.kind) {
+        // add new bird to birds_ based on type, birds wait in a row next to the slingshot
+        case RecordKind::Bird: {
+            if (record.type == static_cast<std::uint8_t>(BirdType::Red)) {
+                birds_.push_back(ObjectPool::make<RedBird>(pool_, 40 * birdcount + 130, 585));
             }
-
-            // handle pigs section, create and add all pigs to vector
-            else if (line == "Pigs") {
-                while (std::getline(ifs, item) && item != "") {
-                    props.clear(); // clear props for each pig
-                    // string stream for reading pig properties from item
-                    std::istringstream iss(item);
-                    // read each property and add to vector
-                    while (std::getline(iss, prop, ' ')) {
-                        props.push_back(prop);
-                    }
-                    // add new pig to pigs_ based on read properties in props vector
-                    if (props[0] == "King") { 
-                        std::shared_ptr<KingPig> pig = std::make_shared<KingPig>(std::stod(props[1]), std::stod(props[2]));
-                        pigs_.push_back(pig);
-                    }
-                    else if (props[0] == "Normal") { 
-                        std::shared_ptr<NormalPig> pig = std::make_shared<NormalPig>(std::stod(props[1]), std::stod(props[2]));
-                        pigs_.push_back(pig);
-                    }
-                    else { throw std::runtime_error("Corrupted game file at Pigs!"); }
-                }
+            else if (record.type == static_cast<std::uint8_t>(BirdType::Yellow)) {
+                birds_.push_back(ObjectPool::make<YellowBird>(pool_, 40 * birdcount + 130, 590));
             }
-
-            // handle obstacles section
-            else if (line == "Obstacles") {
-                while (std::getline(ifs, item) && item != "") {
-                    props.clear(); // clear props for each obstacle
-                    // string stream for reading obstacle properties from item
-                    std::istringstream iss(item);
-                    // read each property and add to vector
-                    while (std::getline(iss, prop, ' ')) {
-                        props.push_back(prop);
-                    }
-                    // add new obstacle to obstacles_ based on read properties in props vector
-                    if (props[0] == "Wood") { 
-                        std::shared_ptr<WoodObstacle> obstacle = std::make_shared<WoodObstacle>(std::stod(props[1]), std::stod(props[2]));
-                        obstacles_.push_back(obstacle);
-                    }
-                    else if (props[0] == "Stone") { 
-                        std::shared_ptr<StoneObstacle> obstacle = std::make_shared<StoneObstacle>(std::stod(props[1]), std::stod(props[2]));
-                        obstacles_.push_back(obstacle);
-                    }
-                    else if (props[0] == "Glass") { 
-                        std::shared_ptr<GlassObstacle> obstacle = std::make_shared<GlassObstacle>(std::stod(props[1]), std::stod(props[2]));
-                        obstacles_.push_back(obstacle);
-                    }
-                    else { throw std::runtime_error("Corrupted game file at Obstacles!"); }
-                }
+            else { throw std::runtime_error("Corrupted game file at Birds!"); }
+            birdcount++;
+            break;
+        }
+        // add new pig to pigs_ based on type
+        case RecordKind::Pig: {
+            if (record.type == static_cast<std::uint8_t>(PigType::King)) {
+                pigs_.push_back(ObjectPool::make<KingPig>(pool_, record.x, record.y));
             }
-
-            else if (line == "Star") {
-                while (std::getline(ifs, item) && item != "") {
-                    props.clear(); // clear props
-                    // string stream for reading star place
-                    std::istringstream iss(item);
-                    // read each property and add to vector
-                    while (std::getline(iss, prop, ' ')) {
-                        props.push_back(prop);
-                    }
-                    // add star based on read properties in props vector
-                    star_ = std::make_shared<Star>(std::stod(props[0]), std::stod(props[1]));
-                }
+            else if (record.type == static_cast<std::uint8_t>(PigType::Normal)) {
+                pigs_.push_back(ObjectPool::make<NormalPig>(pool_, record.x, record.y));
+            }
+            else { throw std::runtime_error("Corrupted game file at Pigs!"); }
+            break;
+        }
+        // add new obstacle to obstacles_ based on type
+        case RecordKind::Obstacle: {
+            if (record.type == static_cast<std::uint8_t>(ObstacleType::Wood)) {
+                obstacles_.push_back(ObjectPool::make<WoodObstacle>(pool_, record.x, record.y));
             }
+            else if (record.type == static_cast<std::uint8_t>(ObstacleType::Stone)) {
+                obstacles_.push_back(ObjectPool::make<StoneObstacle>(pool_, record.x, record.y));
+            }
+            else if (record.type == static_cast<std::uint8_t>(ObstacleType::Glass)) {
+                obstacles_.push_back(ObjectPool::make<GlassObstacle>(pool_, record.x, record.y));
+            }
+            else { throw std::runtime_error("Corrupted game file at Obstacles!"); }
+            break;
+        }
+        case RecordKind::Star: {
+            star_ = ObjectPool::make<Star>(pool_, record.x, record.y);
+            break;
         }
+        default: { throw std::runtime_error("Corrupted game file!"); }
     }
 }
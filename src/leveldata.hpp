@@ -11,8 +11,9 @@
 #include "pig_types.hpp"
 #include "obstacle_types.hpp"
 #include "ground.hpp"
-#include "slingshot.hpp"
 #include "star.hpp"
+#include "levelfile.hpp"
+#include "objectpool.hpp"
 
 
 /**
@@ -25,21 +26,44 @@
 
 class LevelData {
 public:
+    static constexpr float kMinWidth = 1366.0f;     // width of the window in pixels
+    static constexpr float kRightMargin = 300.0f;   // ground right of the rightmost object in a wide level
+
     /**
      * @brief Constructs a new Level object.
      * 
-     * Initializes the Level object based on information read from textfile.
-     * Creates filestream of textfile and reads each line from filestream. 
-     * Creates stringstream of each line and processes the line token by token.
-     * The first token informes if the line contains information about birds, pigs, 
-     * or obstacles. 
-     * Based on the rest of the tokens on the line, new Bird, Pig or Obstacle 
-     * objects are created and added to corresponding vectors birds_, pigs_ and objects_.
-     * @param filename The file where the level information is read.
+     * Initializes the Level object based on information read from the level file.
+     * If a compiled copy of the text file (levelN.bin) exists and is up to date, the
+     * records are read straight from the memory mapped binary file. Otherwise the text
+     * file is parsed line by line and compiled so the next load can skip the parsing.
+     * Based on the records, new Bird, Pig or Obstacle objects are created and added
+     * to corresponding vectors birds_, pigs_ and objects_. All objects of the level are
+     * allocated from one ObjectPool sized for the records.
+     * @param number The number of the level, 4 is the sandbox level.
      */
     LevelData() {}
 
-    LevelData(int number) { loadFromFile(number); }
+    LevelData(int number) { loadFromFile(getLevelPath(number)); }
+
+    /**
+     * @brief Constructs a new Level object from a level file.
+     * 
+     * @param filepath Path to a text level or a compiled ".bin" level.
+     */
+    LevelData(const std::string& filepath) { loadFromFile(filepath); }
+
+    /**
+     * @brief Get the path of the text file of a level.
+     * 
+     * @param number The number of the level, 4 is the sandbox level.
+     * @return The path of the level file.
+     */
+    static std::string getLevelPath(int number) {
+        if (number == 4) {
+            return "../src/textfiles/sandboxlevel.txt";
+        }
+        return "../src/textfiles/level" + std::to_string(number) + ".txt";
+    }
 
     /**
     * @brief Get vector of birds that belong to the level.
@@ -68,12 +92,51 @@ public:
 
     std::shared_ptr<Star> getStar() { return star_; }
 
+    /**
+     * @brief Get the width of the level in pixels.
+     * 
+     * At least the width of the window, wider when objects lie further right, the ground reaches that far.
+     */
+    float getWidth() const { return width_; }
+
+    /**
+     * @brief Get the pool the objects of the level are allocated from.
+     * 
+     * @return The pool, objects added to the level later should be made from it too.
+     */
+    std::shared_ptr<ObjectPool> getPool() { return pool_; }
+
 private:
-    void loadFromFile(int number);
+    void loadFromFile(const std::string& filepath);
+
+    /**
+     * @brief Create the objects of a compiled level, reading the records from the mapped file.
+     * 
+     * @throws std::runtime_error if the file cannot be opened or is corrupted.
+     */
+    void loadCompiled(const std::string& filepath);
+
+    /**
+     * @brief Create the object described by one record and add it to the level.
+     * 
+     * @param record The record to create the object from.
+     * @param birdcount Number of birds added so far, birds are lined up next to the slingshot.
+     */
+    void addRecord(const LevelRecord& record, int& birdcount);
+
+    /**
+     * @brief Create the pool of the level and the ground.
+     * 
+     * @param records Number of records of the level, the pool is sized to fit all of them.
+     * @param right The rightmost x-coordinate of the records in pixels.
+     */
+    void beginLevel(std::size_t records, float right);
 
     std::vector<std::shared_ptr<Bird>> birds_;
     std::vector<std::shared_ptr<Pig>> pigs_;
     std::vector<std::shared_ptr<Obstacle>> obstacles_;
     std::shared_ptr<Ground> ground_;
     std::shared_ptr<Star> star_;
+    std::shared_ptr<ObjectPool> pool_;
+    float width_ = kMinWidth;
 };
@@ -0,0 +1,139 @@
+#include "levelfile.hpp"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    const char kMagic[4] = { 'A', 'B', 'L', 'V' };
+
+    // split a line of the text format at spaces
+    std::vector<std::string> tokens(const std::string& line) {
+        std::vector<std::string> props;
+        std::istringstream iss(line);
+        std::string prop;
+        while (std::getline(iss, prop, ' ')) {
+            props.push_back(prop);
+        }
+        return props;
+    }
+
+    LevelRecord makeRecord(RecordKind kind, std::uint8_t type, float x, float y) {
+        LevelRecord record;
+        record.kind = kind;
+        record.type = type;
+        record.reserved = 0;
+        record.x = x;
+        record.y = y;
+        return record;
+    }
+}
+
+LevelFile::LevelFile(const std::string& path) : file_(path) {
+    LevelHeader header;
+    if (file_.size() < sizeof(header)) {
+        throw std::runtime_error("Corrupted compiled level " + path + "!");
+    }
+    std::memcpy(&header, file_.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion
+        || header.recordSize != sizeof(LevelRecord) || header.byteOrder != kByteOrder
+        || file_.size() != sizeof(header) + static_cast<std::size_t>(header.recordCount) * sizeof(LevelRecord)) {
+        throw std::runtime_error("Corrupted compiled level " + path + "!");
+    }
+    count_ = header.recordCount;
+}
+
+LevelRecord LevelFile::record(std::size_t index) const {
+    LevelRecord record;
+    std::memcpy(&record, file_.data() + sizeof(LevelHeader) + index * sizeof(LevelRecord), sizeof(record));
+    return record;
+}
+
+std::vector<LevelRecord> LevelFile::parseText(const std::string& path) {
+    std::ifstream ifs(path);    // file stream for reading the level file
+    // check if file opened successfully
+    if (!ifs) {
+        throw std::runtime_error("Failed opening the file " + path + "!");
+    }
+    std::vector<LevelRecord> records;
+    std::string line;
+    std::string item;
+    // read each line from file stream
+    while (std::getline(ifs, line)) {
+        // handle birds section, one type per line
+        if (line == "Birds") {
+            while (std::getline(ifs, item) && item != "") {
+                std::vector<std::string> props = tokens(item);
+                if (props.empty()) { throw std::runtime_error("Corrupted game file at Birds!"); }
+                if (props[0] == "Red") { records.push_back(makeRecord(RecordKind::Bird, static_cast<std::uint8_t>(BirdType::Red), 0, 0)); }
+                else if (props[0] == "Yellow") { records.push_back(makeRecord(RecordKind::Bird, static_cast<std::uint8_t>(BirdType::Yellow), 0, 0)); }
+                else { throw std::runtime_error("Corrupted game file at Birds!"); }
+            }
+        }
+        // handle pigs section, "type x y" per line
+        else if (line == "Pigs") {
+            while (std::getline(ifs, item) && item != "") {
+                std::vector<std::string> props = tokens(item);
+                if (props.size() < 3) { throw std::runtime_error("Corrupted game file at Pigs!"); }
+                std::uint8_t type;
+                if (props[0] == "King") { type = static_cast<std::uint8_t>(PigType::King); }
+                else if (props[0] == "Normal") { type = static_cast<std::uint8_t>(PigType::Normal); }
+                else { throw std::runtime_error("Corrupted game file at Pigs!"); }
+                records.push_back(makeRecord(RecordKind::Pig, type, std::stof(props[1]), std::stof(props[2])));
+            }
+        }
+        // handle obstacles section, "type x y" per line
+        else if (line == "Obstacles") {
+            while (std::getline(ifs, item) && item != "") {
+                std::vector<std::string> props = tokens(item);
+                if (props.size() < 3) { throw std::runtime_error("Corrupted game file at Obstacles!"); }
+                std::uint8_t type;
+                if (props[0] == "Wood") { type = static_cast<std::uint8_t>(ObstacleType::Wood); }
+                else if (props[0] == "Stone") { type = static_cast<std::uint8_t>(ObstacleType::Stone); }
+                else if (props[0] == "Glass") { type = static_cast<std::uint8_t>(ObstacleType::Glass); }
+                else { throw std::runtime_error("Corrupted game file at Obstacles!"); }
+                records.push_back(makeRecord(RecordKind::Obstacle, type, std::stof(props[1]), std::stof(props[2])));
+            }
+        }
+        // handle star section, "x y"
+        else if (line == "Star") {
+            while (std::getline(ifs, item) && item != "") {
+                std::vector<std::string> props = tokens(item);
+                if (props.size() < 2) { throw std::runtime_error("Corrupted game file at Star!"); }
+                records.push_back(makeRecord(RecordKind::Star, 0, std::stof(props[0]), std::stof(props[1])));
+            }
+        }
+    }
+    return records;
+}
+
+void LevelFile::writeBinary(const std::string& path, const std::vector<LevelRecord>& records) {
+    std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+    if (!ofs) {
+        throw std::runtime_error("Failed opening the file " + path + " for writing!");
+    }
+    LevelHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.recordSize = sizeof(LevelRecord);
+    header.recordCount = static_cast<std::uint32_t>(records.size());
+    header.byteOrder = kByteOrder;
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(LevelRecord));
+    if (!ofs) {
+        throw std::runtime_error("Failed writing the file " + path + "!");
+    }
+}
+
+bool LevelFile::isCompiledPath(const std::string& path) {
+    return path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+}
+
+std::string LevelFile::compiledPath(const std::string& textPath) {
+    std::size_t dot = textPath.find_last_of('.');
+    std::size_t slash = textPath.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return textPath + ".bin";
+    }
+    return textPath.substr(0, dot) + ".bin";
+}
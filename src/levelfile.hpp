@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "mappedfile.hpp"
+
+/**
+ * @brief Which section of a level an entry belongs to.
+ */
+enum class RecordKind : std::uint8_t { Bird = 0, Pig = 1, Obstacle = 2, Star = 3 };
+
+/**
+ * @brief Types of the entries, stored in LevelRecord::type.
+ */
+enum class BirdType : std::uint8_t { Red = 0, Yellow = 1 };
+enum class PigType : std::uint8_t { Normal = 0, King = 1 };
+enum class ObstacleType : std::uint8_t { Wood = 0, Stone = 1, Glass = 2 };
+
+/**
+ * @brief One bird, pig, obstacle or star of a level.
+ *
+ * Positions are in pixels like in the text format. Birds have no position,
+ * they are lined up next to the slingshot in the order they appear.
+ */
+struct LevelRecord {
+    RecordKind kind;
+    std::uint8_t type;
+    std::uint16_t reserved;
+    float x;
+    float y;
+};
+
+/**
+ * @brief Header at the start of a compiled level file.
+ */
+struct LevelHeader {
+    char magic[4];              // "ABLV"
+    std::uint16_t version;      // LevelFile::kVersion
+    std::uint16_t recordSize;   // sizeof(LevelRecord), guards against layout changes
+    std::uint32_t recordCount;  // number of records following the header
+    std::uint32_t byteOrder;    // LevelFile::kByteOrder as written by the compiling host
+};
+
+/**
+ * @class LevelFile
+ * @brief Reads and writes levels in the text and the compiled binary format.
+ *
+ * A compiled level is a LevelHeader followed by packed LevelRecords, grouped by kind in
+ * the same order as the sections of the text format. All values are in the native byte
+ * order of the host that wrote the file, so the .bin cache is not portable: a file from a
+ * host of the other byte order fails the byteOrder check and is rejected like a corrupted
+ * one. Opening a compiled level memory maps the file, the records are read straight from
+ * the mapping without any parsing.
+ */
+class LevelFile {
+public:
+    static const std::uint16_t kVersion = 2;
+    static const std::uint32_t kByteOrder = 0x01020304;    // reads as 0x04030201 on a host of the other byte order
+
+    /**
+     * @brief Map a compiled level file and validate its header.
+     *
+     * @param path Path to the compiled level.
+     * @throws std::runtime_error if the file cannot be opened or is not a compiled level of this version.
+     */
+    explicit LevelFile(const std::string& path);
+
+    /**
+     * @brief Get the number of records in the level.
+     */
+    std::size_t size() const { return count_; }
+
+    /**
+     * @brief Get a record of the level.
+     *
+     * @param index Index of the record, smaller than size().
+     */
+    LevelRecord record(std::size_t index) const;
+
+    /**
+     * @brief Parse a level in the text format.
+     *
+     * @param path Path to the text file.
+     * @return The records of the level in file order.
+     * @throws std::runtime_error if the file cannot be opened or contains unknown entries.
+     */
+    static std::vector<LevelRecord> parseText(const std::string& path);
+
+    /**
+     * @brief Write records as a compiled level file.
+     *
+     * @param path Path of the file to write.
+     * @param records The records of the level.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    static void writeBinary(const std::string& path, const std::vector<LevelRecord>& records);
+
+    /**
+     * @brief Convert a text level into a compiled level file.
+     *
+     * @param textPath Path to the text level.
+     * @param binaryPath Path of the compiled file to write.
+     */
+    static void compile(const std::string& textPath, const std::string& binaryPath) {
+        writeBinary(binaryPath, parseText(textPath));
+    }
+
+    /**
+     * @brief Check if a path names a compiled level by its ".bin" extension.
+     */
+    static bool isCompiledPath(const std::string& path);
+
+    /**
+     * @brief Get the path of the compiled file that caches a text level, "level1.txt" -> "level1.bin".
+     */
+    static std::string compiledPath(const std::string& textPath);
+
+private:
+    MappedFile file_;           // The mapped level file
+    std::size_t count_ = 0;     // Number of records in the file
+};
@@ -0,0 +1,280 @@
+#include "levelsimulation.hpp"
+#include "profiler.hpp"
+#include <cmath>
+
+LevelSimulation::LevelSimulation(LevelData data) : world_(b2Vec2(0.0f, kGravity)), scheduler_(kTimeStep, kMaxStepsPerFrame) {
+    TRACE_ZONE("initializePhysicsWorld");
+    for (auto& bird : data.getBirds()) {
+        bird->initializePhysicsWorld(world_); // adds bird to b2 world
+        birds_.push_back(bird);
+    }
+    for (auto& pig : data.getPigs()) {
+        pig->initializePhysicsWorld(world_); // adds pig to b2 world
+        pigs_.push_back(pig);
+    }
+    for (auto& obstacle : data.getObstacles()) {
+        obstacle->initializePhysicsWorld(world_); // adds obstacle to b2 world
+        obstacles_.push_back(obstacle);
+    }
+    empty_ = birds_.empty() || pigs_.empty();
+    levelWidth_ = data.getWidth();
+    ground_ = data.getGround();
+    ground_->initializePhysicsWorld(world_); // adds ground to b2 world
+    ground_->setData(); // ground knows it is "ground"
+    ground_->moveBodyDown(0.05f); // move ground body down 5 pixels so objects do not levitate
+    star_ = data.getStar();
+    if (star_) {
+        star_->initializePhysicsWorld(world_);
+        star_->setData();
+        star_->setBodyStatic();
+        star_->getBody()->GetFixtureList()->SetSensor(true);
+    }
+    world_.SetContactListener(&collisionListener_); // connect a self-made collisionlistener object to the b2 world
+    collisionListener_.setMaterials(&Materials::getDefault());
+    collisionListener_.setAwakeSet(&awake_);
+    registerObjects();
+
+    // reset() returns every object to this state
+    for (auto& bird : birds_) { bird->saveInitialState(); }
+    for (auto& pig : pigs_) { pig->saveInitialState(); }
+    for (auto& obstacle : obstacles_) { obstacle->saveInitialState(); }
+    if (star_) { star_->saveInitialState(); }
+    ground_->saveInitialState();
+}
+
+void LevelSimulation::reset() {
+    // disabling every body first drops all contacts of the previous attempt
+    for (b2Body* body = world_.GetBodyList(); body; body = body->GetNext()) {
+        body->SetEnabled(false);
+    }
+    awake_.clear();
+    for (auto& bird : birds_) { bird->restoreInitialState(); }
+    for (auto& pig : pigs_) { pig->restoreInitialState(); }
+    for (auto& obstacle : obstacles_) { obstacle->restoreInitialState(); }
+    if (star_) { star_->restoreInitialState(); }
+    ground_->restoreInitialState();
+    collisionListener_.reset();
+    registerObjects();
+    sounds_.clear();
+    birdInTurn_ = -1;
+    score_ = 0;
+    scheduler_.reset();
+    time_ = 0;
+    status_ = SimulationStatus::Running;
+    settleEnd_ = 0;
+    restTime_ = 0;
+    outOfBirds_ = false;
+}
+
+bool LevelSimulation::placeBird(std::size_t index) {
+    if (index >= birds_.size() || birds_[index]->isShot()) {
+        return false;
+    }
+    birdInTurn_ = static_cast<int>(index);
+    b2Vec2 newPos(kSlingshotX / 100.0f, kSlingshotY / 100.0f);
+    birds_[index]->setTransform(newPos, 0);
+    birds_[index]->Update();
+    return true;
+}
+
+bool LevelSimulation::placeNextBird() {
+    for (std::size_t i = 0; i < birds_.size(); i++) {
+        if (!birds_[i]->isShot()) {
+            return placeBird(i);
+        }
+    }
+    return false;
+}
+
+void LevelSimulation::aimBird(sf::Vector2f offset) {
+    std::shared_ptr<Bird> bird = getBirdInTurn();
+    if (bird && !bird->isShot()) {
+        b2Vec2 newPos((kSlingshotX + offset.x) / 100.0f, (kSlingshotY + offset.y) / 100.0f);
+        bird->setTransform(newPos, 0);
+        bird->Update();
+    }
+}
+
+bool LevelSimulation::launch(std::size_t index, b2Vec2 impulse) {
+    if (!placeBird(index)) {
+        return false;
+    }
+    aimBird(sf::Vector2f(-7.0f * impulse.x, -7.0f * impulse.y));
+    Bird& bird = *birds_[index];
+    bird.setBodyDynamic();
+    bird.setVelocity(impulse);
+    bird.fly();
+    bird.shoot();
+    awake_.add(&bird);
+    sounds_.push_back(SoundEvent{ &bird, impulse.Length() });
+    updateStatus();
+    return true;
+}
+
+bool LevelSimulation::useSpecialAction() {
+    std::shared_ptr<Bird> bird = getBirdInTurn();
+    if (bird && bird->isFlying() && !bird->isSpecialActionUsed()) {
+        bird->SpecialAction();
+        awake_.add(bird.get());
+        return true;
+    }
+    return false;
+}
+
+void LevelSimulation::finishTurn() {
+    std::shared_ptr<Bird> bird = getBirdInTurn();
+    if (bird && bird->isShot() && !bird->isFlying()) {
+        bird->kill();
+        birdInTurn_ = -1;
+    }
+}
+
+void LevelSimulation::step(int steps) {
+    runSteps(steps);
+    updateObjects(1.0f);
+}
+
+int LevelSimulation::advance(double seconds) {
+    int steps = scheduler_.advance(seconds);
+    runSteps(steps);
+    updateObjects(scheduler_.getAlpha());
+    PROFILE_GAUGE(ProfileCounter::Bodies, world_.GetBodyCount());
+    PROFILE_GAUGE(ProfileCounter::Contacts, world_.GetContactCount());
+    return steps;
+}
+
+void LevelSimulation::runSteps(int steps) {
+    for (int i = 0; i < steps; i++) {
+        if (i == steps - 1) {
+            // the objects are drawn between the transforms before and after the last step
+            awake_.savePreviousTransforms();
+        }
+        {
+            PROFILE_SCOPE(ProfileSection::Physics);
+            world_.Step(kTimeStep, 8, 3); // Updates the b2World by 1 "step"
+        }
+        collisionListener_.step(kTimeStep);
+        time_ += kTimeStep;
+
+        // remove destroyed objects from the b2 world
+        // the bodies are only disabled so that reset can bring them back
+        for (ObjectHandle handle : collisionListener_.getRemovalQueue()) {
+            if (Object* object = handles_.get(handle)) {
+                object->getBody()->SetEnabled(false);
+                handles_.remove(handle);
+            }
+        }
+        collisionListener_.clearRemovalQueue();
+        const std::vector<SoundEvent>& speakers = collisionListener_.getSpeakers();
+        sounds_.insert(sounds_.end(), speakers.begin(), speakers.end());
+        collisionListener_.clearSpeakers();
+        if (status_ == SimulationStatus::Settling) {
+            restTime_ = isAtRest() ? restTime_ + kTimeStep : 0;
+        }
+        updateStatus();
+    }
+}
+
+void LevelSimulation::registerObjects() {
+    handles_.clear();
+    for (auto& bird : birds_) { bird->setHandle(handles_.add(bird.get())); }
+    for (auto& pig : pigs_) { pig->setHandle(handles_.add(pig.get())); }
+    for (auto& obstacle : obstacles_) { obstacle->setHandle(handles_.add(obstacle.get())); }
+    if (star_) { star_->setHandle(handles_.add(star_.get())); }
+    ground_->setHandle(handles_.add(ground_.get()));
+    // slots in the order the objects are drawn
+    transforms_.clear();
+    auto addSlot = [this](Object& object) {
+        float radius = std::hypot(object.getWidth(), object.getHeight()) / 2;
+        object.setTransformSlot(&transforms_, transforms_.add(&object, *object.getBody(), radius));
+    };
+    if (star_) { addSlot(*star_); }
+    for (auto& bird : birds_) { addSlot(*bird); }
+    for (auto& pig : pigs_) { addSlot(*pig); }
+    for (auto& obstacle : obstacles_) { addSlot(*obstacle); }
+    // everything is synced once, then only what keeps moving
+    for (auto& bird : birds_) { awake_.add(bird.get()); }
+    for (auto& pig : pigs_) { awake_.add(pig.get()); }
+    for (auto& obstacle : obstacles_) { awake_.add(obstacle.get()); }
+    if (star_) { awake_.add(star_.get()); }
+}
+
+void LevelSimulation::updateObjects(float alpha) {
+    PROFILE_SCOPE(ProfileSection::Sync);
+    awake_.update(alpha);
+    transforms_.toPixels(alpha);
+}
+
+void LevelSimulation::updateStatus() {
+    if (status_ == SimulationStatus::Running && !empty_) {
+        if (birdsAlive() == 0 || pigsAlive() == 0) {
+            // the verdict waits until the last bird and whatever it hits have come to rest
+            status_ = SimulationStatus::Settling;
+            settleEnd_ = time_ + kMaxSettleTime;
+            restTime_ = 0;
+            outOfBirds_ = birdsAlive() == 0 && pigsAlive() > 0;
+        }
+    }
+    else if (status_ == SimulationStatus::Settling) {
+        bool pigsDead = outOfBirds_ && pigsAlive() == 0;
+        if (pigsDead || restTime_ >= kRestTime || time_ >= settleEnd_) {
+            if (outOfBirds_) {
+                status_ = pigsAlive() > 0 ? SimulationStatus::Lost : SimulationStatus::Won;
+            }
+            else {
+                // birds left after a win give bonus points
+                score_ += 5000 * birdsAlive();
+                status_ = SimulationStatus::Won;
+            }
+        }
+    }
+}
+
+bool LevelSimulation::isAtRest() const {
+    const float restSpeedSquared = kRestSpeed * kRestSpeed;
+    for (Object* object : awake_.getObjects()) {
+        const b2Body* body = object->getBody();
+        if (!body || !body->IsAwake() || !body->IsEnabled() || body->GetType() != b2_dynamicBody
+            || body->GetPosition().y * 100.0f > kFallenY) {
+            continue;
+        }
+        if (body->GetLinearVelocity().LengthSquared() > restSpeedSquared || std::abs(body->GetAngularVelocity()) > kRestSpeed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SimulationResult LevelSimulation::result() const {
+    SimulationResult result;
+    result.status = status_;
+    result.score = getScore();
+    result.pigsKilled = static_cast<int>(pigs_.size()) - pigsAlive();
+    result.simulatedTime = time_;
+    if (star_) {
+        result.stars = 1;
+        if (star_->getHp() == 0) { result.stars++; }
+        if (result.score >= 5000) { result.stars++; }
+    }
+    return result;
+}
+
+int LevelSimulation::pigsAlive() const {
+    int sum = 0;
+    for (const auto& pig : pigs_) {
+        if (pig->getHp() > 0) {
+            sum++;
+        }
+    }
+    return sum;
+}
+
+int LevelSimulation::birdsAlive() const {
+    int sum = 0;
+    for (const auto& bird : birds_) {
+        if (!(bird->isShot())) {
+            sum++;
+        }
+    }
+    return sum;
+}
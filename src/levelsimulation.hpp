@@ -0,0 +1,281 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <box2d/box2d.h>
+#include "leveldata.hpp"
+#include "collisiondetection.hpp"
+#include "fixedstepscheduler.hpp"
+#include "awakeset.hpp"
+#include "transformbuffer.hpp"
+
+/**
+ * @brief Phase of a simulated level.
+ */
+enum class SimulationStatus {
+    Running,    // birds left and pigs alive
+    Settling,   // out of birds or pigs, waiting for the world to come to rest before the verdict
+    Won,
+    Lost
+};
+
+/**
+ * @brief Outcome of a simulated level, see LevelSimulation::result().
+ */
+struct SimulationResult {
+    SimulationStatus status = SimulationStatus::Running;
+    int score = 0;              // collision score plus the bonus of unused birds
+    int stars = 0;              // 0 if the level has no star
+    int pigsKilled = 0;
+    float simulatedTime = 0;    // seconds of physics simulated since the level was built or reset
+};
+
+/**
+ * @class LevelSimulation
+ * @brief The gameplay of a level without a window: physics world, objects, shots and score.
+ *
+ * Owns the Box2D world and the objects of a level and advances them with a fixed time step.
+ * It has no graphics or audio dependency, LevelState draws it and plays its sounds, and
+ * tools can run it headless to simulate shots.
+ */
+class LevelSimulation {
+public:
+    static constexpr float kTimeStep = 1.0f / 60.0f;   // length of one physics step in seconds
+    static constexpr float kGravity = 9.8f;            // downwards, in meters per second squared
+    static constexpr float kLevelWidth = LevelData::kMinWidth;    // width of a level of one screen in pixels
+    static constexpr int kMaxStepsPerFrame = 5;        // advance() drops the time of any further steps
+    static constexpr float kSlingshotX = 145.0f;       // where birds are launched from in pixels, same as Slingshot
+    static constexpr float kSlingshotY = 520.0f;
+    static constexpr float kMaxSettleTime = 10.0f;     // longest wait for the world to come to rest before the verdict, in simulated seconds
+    static constexpr float kRestTime = 0.5f;           // the world must stay at rest this long to give the verdict
+    static constexpr float kRestSpeed = 0.05f;         // a body slower than this in m/s (and rad/s) counts as at rest
+    static constexpr float kFallenY = 1000.0f;         // a body below this in pixels has fallen off the level and counts as at rest
+
+    /**
+     * @brief Build the physics world from the objects of a level.
+     *
+     * @param data The level, its objects are moved into the simulation.
+     */
+    explicit LevelSimulation(LevelData data);
+
+    LevelSimulation(const LevelSimulation&) = delete;
+    LevelSimulation& operator=(const LevelSimulation&) = delete;
+
+    /**
+     * @brief Reset the level to the state it was built in.
+     *
+     * The existing objects and bodies are reused, nothing is created again.
+     */
+    void reset();
+
+    /**
+     * @brief Put a bird on the slingshot and make it the bird in turn.
+     *
+     * @param index Index of the bird in getBirds().
+     * @return Boolean value 'false' if there is no such bird or it has been shot already.
+     */
+    bool placeBird(std::size_t index);
+
+    /**
+     * @brief Put the first bird that has not been shot on the slingshot.
+     *
+     * @return Boolean value 'false' if every bird has been shot.
+     */
+    bool placeNextBird();
+
+    /**
+     * @brief Move the bird in turn while it is pulled back in the slingshot.
+     *
+     * @param offset Offset from the slingshot in pixels.
+     */
+    void aimBird(sf::Vector2f offset);
+
+    /**
+     * @brief Shoot a bird.
+     *
+     * The bird is pulled back from the slingshot by 7 times the impulse in pixels,
+     * like when it is dragged, and released with the impulse as its velocity.
+     *
+     * @param index Index of the bird in getBirds().
+     * @param impulse Launch velocity in meters per second.
+     * @return Boolean value 'false' if there is no such bird or it has been shot already.
+     */
+    bool launch(std::size_t index, b2Vec2 impulse);
+
+    /**
+     * @brief Get the impulse of a bird released at a given offset from the slingshot.
+     *
+     * @param offset Offset from the slingshot in pixels.
+     */
+    static b2Vec2 impulseFromOffset(sf::Vector2f offset) { return b2Vec2(-offset.x / 7.0f, -offset.y / 7.0f); }
+
+    /**
+     * @brief Use the special action of the bird in turn if it is flying and has not used it yet.
+     *
+     * @return Boolean value 'true' if the special action was used.
+     */
+    bool useSpecialAction();
+
+    /**
+     * @brief End the turn of the bird in turn if it has been shot and has landed.
+     */
+    void finishTurn();
+
+    /**
+     * @brief Advance the simulation by whole physics steps.
+     *
+     * The objects are updated to their exact positions after the last step.
+     *
+     * @param steps Number of steps of kTimeStep seconds.
+     */
+    void step(int steps = 1);
+
+    /**
+     * @brief Advance the simulation by an amount of real time.
+     *
+     * The time is simulated in whole steps by the scheduler, at most kMaxStepsPerFrame per call.
+     * The objects are updated between their last two steps by the time left over, so that
+     * they move smoothly when the frame rate differs from the step rate.
+     *
+     * @param seconds Elapsed time.
+     * @return Number of steps taken.
+     */
+    int advance(double seconds);
+
+    /**
+     * @brief Get the objects that are still moving, only they are updated after a step.
+     */
+    const AwakeSet& getAwakeSet() const { return awake_; }
+
+    /**
+     * @brief Get the drawn transforms of the star, birds, pigs and obstacles, in drawing order.
+     */
+    const TransformBuffer& getTransforms() const { return transforms_; }
+
+    /**
+     * @brief Get the scheduler of advance(), it reports the steps run and dropped per frame.
+     */
+    const FixedStepScheduler& getScheduler() const { return scheduler_; }
+
+    /**
+     * @brief Get the current status, score and stars of the level.
+     */
+    SimulationResult result() const;
+
+    /**
+     * @brief Get the current status, cheaper than result() when checked every step.
+     */
+    SimulationStatus getStatus() const { return status_; }
+
+    /**
+     * @brief Get the score collected so far.
+     */
+    int getScore() const { return score_ + collisionListener_.getScore(); }
+
+    /**
+     * @brief Number of pigs that are alive.
+     */
+    int pigsAlive() const;
+
+    /**
+     * @brief Number of birds that have not been shot.
+     */
+    int birdsAlive() const;
+
+    /**
+     * @brief Check if the level has no birds or no pigs, it can then never be won or lost.
+     */
+    bool isEmpty() const { return empty_; }
+
+    /**
+     * @brief Get the objects that made a sound since the last clearSounds().
+     *
+     * Launched birds and objects that were hit, in order, with the launch or impact speed.
+     * An object can appear several times.
+     */
+    const std::vector<SoundEvent>& getSounds() const { return sounds_; }
+
+    /**
+     * @brief Forget the sounds after they have been played.
+     */
+    void clearSounds() { sounds_.clear(); }
+
+    std::vector<std::shared_ptr<Bird>>& getBirds() { return birds_; }
+    std::vector<std::shared_ptr<Pig>>& getPigs() { return pigs_; }
+    std::vector<std::shared_ptr<Obstacle>>& getObstacles() { return obstacles_; }
+    std::shared_ptr<Ground> getGround() { return ground_; }
+    std::shared_ptr<Star> getStar() { return star_; }
+
+    /**
+     * @brief Get the bird on the slingshot or in flight, nullptr if there is none.
+     */
+    std::shared_ptr<Bird> getBirdInTurn() { return birdInTurn_ < 0 ? nullptr : birds_[birdInTurn_]; }
+
+    /**
+     * @brief Get the index of the bird in turn in getBirds(), -1 if there is none.
+     */
+    int getBirdInTurnIndex() const { return birdInTurn_; }
+
+    /**
+     * @brief Get the width of the level in pixels, kLevelWidth or more.
+     */
+    float getLevelWidth() const { return levelWidth_; }
+
+    /**
+     * @brief Get the Box2D world of the level.
+     */
+    b2World& getWorld() { return world_; }
+
+    /**
+     * @brief Check if every awake body is asleep, slower than kRestSpeed or fallen off the level.
+     */
+    bool isAtRest() const;
+
+private:
+    /**
+     * @brief Give every object a fresh handle and transform slot and put it in the awake set, handles of the previous attempt stop resolving.
+     */
+    void registerObjects();
+
+    /**
+     * @brief Run physics steps, saving the transforms before the last one for interpolation.
+     */
+    void runSteps(int steps);
+
+    /**
+     * @brief Update the drawn positions of the objects that moved.
+     *
+     * @param alpha 0 for the transforms before the last step, 1 for the current ones.
+     */
+    void updateObjects(float alpha);
+
+    /**
+     * @brief Move from running to settling and from settling to the verdict.
+     *
+     * Settling ends when every pig is dead, when the world has been at rest for kRestTime,
+     * or after kMaxSettleTime.
+     */
+    void updateStatus();
+
+    b2World world_;
+    CollisionListener collisionListener_;
+    ObjectHandles handles_;         // objects still in the b2 world
+    AwakeSet awake_;                // objects whose drawn transform follows their body
+    TransformBuffer transforms_;    // drawn transforms, declared before the objects that point into it
+    std::vector<std::shared_ptr<Bird>> birds_;
+    std::vector<std::shared_ptr<Pig>> pigs_;
+    std::vector<std::shared_ptr<Obstacle>> obstacles_;
+    std::shared_ptr<Ground> ground_;
+    std::shared_ptr<Star> star_;
+    std::vector<SoundEvent> sounds_;
+    int birdInTurn_ = -1;           // index of the bird in turn, -1 if none
+    int score_ = 0;                 // bonus score, the collision score is kept by the listener
+    bool empty_ = false;
+    float levelWidth_ = kLevelWidth;
+    FixedStepScheduler scheduler_;  // real time given to advance() in steps
+    float time_ = 0;                // simulated seconds
+    SimulationStatus status_ = SimulationStatus::Running;
+    float settleEnd_ = 0;           // simulated time when settling ends at the latest
+    float restTime_ = 0;            // simulated seconds the world has been at rest while settling
+    bool outOfBirds_ = false;       // settling because every bird was shot, otherwise because every pig died
+};
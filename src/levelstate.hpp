@@ -2,19 +2,23 @@
 
 #include "gamestate.hpp"
 #include "leveldata.hpp"
-#include "collisiondetection.hpp"
+#include "levelsimulation.hpp"
+#include "trajectorypreview.hpp"
 #include "highscores.hpp"
+#include "assetcache.hpp"
+#include "voicepool.hpp"
 #include <cmath>
+#include <map>
 #include <memory>
 
     /**
      * @class LevelState
      * @brief Represents the state of a single level in the game.
      * 
-     * This class is responsible for managing the game objects, such as birds, pigs, obstacles,
-     * and the environment, within a single level. It handles the interaction between these objects
-     * and the game's physics system. It also controls the level's state transitions,
-     * such as win, lose, and restarting a level.
+     * This class is the view of a LevelSimulation, which owns the birds, pigs, obstacles and the
+     * physics of the level. It turns the player's input into shots, draws the level, plays the
+     * sounds of the simulation and controls the level's state transitions, such as win, lose,
+     * and restarting a level.
      */
     class LevelState : public GameState {
     public:
@@ -27,39 +31,11 @@
          * 
          * @param number The level number to initialize.
          */
-        LevelState(int number) : level_number_(number), gravity_(0.0f, 9.8f), world_(gravity_), bird_in_turn_(nullptr), highscores_(HighScores().getHighScores(number)), score_(0), collisionListener_(clockForWorld_), level_empty_(false), currentZoom_(1) {
-
-            LevelData data(number);
+        LevelState(int number) : level_number_(number), simulation_(LevelData(number)), highscores_(HighScores().getHighScores(number)), currentZoom_(1) {
+            worldbounds_.width = simulation_.getLevelWidth();   // generated levels can be wider than the window
             initMusic();
             initButtons();
-            for (auto& bird : data.getBirds()) {   
-                bird->initializePhysicsWorld(world_); // adds bird to b2 world
-                birds_.push_back(bird);
-            }
-            for (auto& pig : data.getPigs()) {
-                pig->initializePhysicsWorld(world_); // adds pig to b2 world
-                pigs_.push_back(pig);
-            }
-            for (auto& obstacle : data.getObstacles()) {
-                obstacle->initializePhysicsWorld(world_); // adds obstacle to b2 world
-                obstacles_.push_back(obstacle);
-            }
-            if (birds_.empty() || pigs_.empty()) {
-                level_empty_ = true;
-            }
-            ground_ = data.getGround();
-            ground_->initializePhysicsWorld(world_); // adds ground to b2 world
-            ground_->setData(); // ground knows it is "ground"
-            ground_->moveBodyDown(0.05f); // move ground body down 5 pixels so objects do not levitate
-            star_ = data.getStar();
-            if (star_) {
-                star_->initializePhysicsWorld(world_);
-                star_->setData();
-                star_->setBodyStatic();
-                star_->getBody()->GetFixtureList()->SetSensor(true);
-            }
-            // clockForWorld_.restart(); // Start the clock created to track time since creation of the b2 world
-            world_.SetContactListener(&collisionListener_); // connect a self-made collisionlistener object to the b2 world
+            initSounds();
         }
 
         /**
@@ -69,6 +45,30 @@
             stopMusic();
         }
 
+        /**
+         * @brief Restarts the level in place.
+         * 
+         * Resets the simulation to the state the level was built in,
+         * so nothing is read from disk or created again.
+         * 
+         * @param window The SFML render window.
+         * @param view The SFML view to be reset.
+         */
+        void restart(sf::RenderWindow& window, sf::View& view) {
+            simulation_.reset();
+            voices_.stopAll();
+            preview_.clear();
+            slingshot_.removeBird();
+            dragging_ = false;
+            clicked_ = false;
+            settling_ = false;
+            outOfBirds_ = false;
+            view.reset(sf::FloatRect(0.f, 0.f, 1366.f, 768.f));
+            window.setView(view);
+            currentZoom_ = 1;
+            startMusic();
+        }
+
         /**
          * @brief Initializes the UI buttons for the level.
          * 
@@ -103,6 +103,45 @@
             }
         }
 
+        /**
+         * @brief Looks up the sound of every object of the level.
+         * 
+         * The simulation reports which objects made a sound, they are played in playSounds().
+         * Bird sounds have a higher priority, a collapse never cuts off a launch.
+         */
+        void initSounds() {
+            for (auto& bird : simulation_.getBirds()) { initSound(*bird, 1); }
+            for (auto& pig : simulation_.getPigs()) { initSound(*pig, 0); }
+            for (auto& obstacle : simulation_.getObstacles()) { initSound(*obstacle, 0); }
+            if (simulation_.getStar()) { initSound(*simulation_.getStar(), 1); }
+        }
+
+        /**
+         * @brief Looks up the sound of one object, the buffer is shared by all objects of the same type.
+         * 
+         * @param object The object.
+         * @param priority Priority of the object's sound in the voice pool.
+         */
+        void initSound(Object& object, int priority) {
+            sounds_[&object] = ObjectSound{ AssetCache::getSoundBuffer(object.getSoundFilePath()), priority };
+        }
+
+        /**
+         * @brief Plays the sounds of the objects that were launched or hit since the last call.
+         * 
+         * The sounds are queued in the voice pool, which starts at most one per sound file.
+         */
+        void playSounds() {
+            for (const SoundEvent& event : simulation_.getSounds()) {
+                auto sound = sounds_.find(event.object);
+                if (sound != sounds_.end()) {
+                    voices_.request(*sound->second.buffer, event.strength, sound->second.priority);
+                }
+            }
+            simulation_.clearSounds();
+            voices_.flush();
+        }
+
         /**
          * @brief Starts the background music for the level.
          */
@@ -132,14 +171,7 @@
          * @return The number of stars the player has earned.
          */
         int getStars() const override {
-            if (star_) {
-                int stars = 1;
-                if (star_->getHp() == 0) { stars++; }
-                if (score_ >= 5000) { stars++; }
-                std::cout << "getStars() returns " << stars << "because score is " << score_ << " and starhp is " << star_->getHp() << std::endl;
-                return stars;
-            }
-            return 0;
+            return simulation_.result().stars;
         };
 
         /**
@@ -148,8 +180,7 @@
          * @return The updated score.
          */
         int calculateScore() override {
-            score_ += collisionListener_.getScore(); 
-            return score_;
+            return simulation_.result().score;
         }
 
         /**
@@ -163,6 +194,10 @@
          * @return A pair containing the result of the action.
          */
         std::pair<std::string, int> processEvent(const sf::Event& event, sf::RenderWindow& window, sf::View& view) override {
+            if (settling_) {
+                processSettlingEvent(event, window, view);
+                return getReturn("");
+            }
             std::pair<std::string, int> action;
             for (auto button : buttons_) {
                 action = button->processEvent(event, window, view);
@@ -170,6 +205,11 @@
                     buttonClicked_ = button;
                     clicked_ = true;
                 }
+                else if (action.first == "restart") {
+                    clicked_ = false;
+                    restart(window, view);
+                    return getReturn("");
+                }
                 else if (action != std::pair<std::string, int>("", 0)) { 
                     clicked_ = false;
                     return action;
@@ -193,6 +233,18 @@
                     processWheelScroll(event, window, view);
                     break;
                 }
+                case sf::Event::KeyPressed: {
+                    // T switches the trajectory preview between the arc and the simulated impact
+                    if (event.key.code == sf::Keyboard::T) {
+                        preview_.toggleMode();
+                        if (dragging_) { updatePreview(); }
+                    }
+                    // F fast-forwards the wait for the verdict, also before it starts
+                    else if (event.key.code == sf::Keyboard::F) {
+                        fastForward_ = !fastForward_;
+                    }
+                    break;
+                }
                 default: {
                     flyMotion(window, view);
                 }
@@ -200,6 +252,38 @@
             return getReturn("");
         }
 
+        /**
+         * @brief Processes input while the level settles before its verdict.
+         * 
+         * Only zooming and fast-forwarding are possible, and the special action of the last bird
+         * if it is still flying.
+         * 
+         * @param event The SFML event to process.
+         * @param window The SFML render window.
+         * @param view The SFML view to be updated.
+         */
+        void processSettlingEvent(const sf::Event& event, sf::RenderWindow& window, sf::View& view) {
+            switch (event.type) {
+                case sf::Event::MouseButtonPressed: {
+                    if (outOfBirds_) {
+                        simulation_.useSpecialAction();
+                    }
+                    break;
+                }
+                case sf::Event::MouseWheelScrolled: {
+                    processWheelScroll(event, window, view);
+                    break;
+                }
+                case sf::Event::KeyPressed: {
+                    if (event.key.code == sf::Keyboard::F) {
+                        fastForward_ = !fastForward_;
+                    }
+                    break;
+                }
+                default: { break; }
+            }
+        }
+
         /**
          * @brief Handles mouse button press events during gameplay.
          * 
@@ -210,48 +294,38 @@
          * @param view The SFML view to be updated.
          */
         void processMouseButtonPress(const sf::Event& event, sf::RenderWindow& window, sf::View& view) {
-            if (bird_in_turn_) {
-                if (bird_in_turn_->isShot() && !bird_in_turn_->isFlying()) {
-                    std::cout << "bird killed" << std::endl;
-                    bird_in_turn_->kill(); 
-                    bird_in_turn_ = nullptr;
-                }
-            }
+            simulation_.finishTurn(); // a shot bird that has landed is done
+            std::shared_ptr<Bird> bird_in_turn = simulation_.getBirdInTurn();
             if (event.mouseButton.button == sf::Mouse::Left) {  // left button click
                 sf::Vector2i position = sf::Mouse::getPosition(window);
                 sf::Vector2f globalPosition = window.mapPixelToCoords(position);
                 // std::cout << "mouse position when pressed: " << globalPosition.x << " " << globalPosition.y << std::endl;
-                if (bird_in_turn_ && bird_in_turn_->isFlying() && !(bird_in_turn_->isSpecialActionUsed())) {
+                if (bird_in_turn && bird_in_turn->isFlying() && !(bird_in_turn->isSpecialActionUsed())) {
                     std::cout << "special action used" << std::endl;
-                    bird_in_turn_->SpecialAction();
+                    simulation_.useSpecialAction();
                 }
                 // if background clicked and there is no bird in turn, put next bird to slingshot
-                else if ((!bird_in_turn_ || (bird_in_turn_->isSpecialActionUsed() && bird_in_turn_->isShot())) && !clicked_) {
+                else if ((!bird_in_turn || (bird_in_turn->isSpecialActionUsed() && bird_in_turn->isShot())) && !clicked_) {
                     view.reset(sf::FloatRect(0.f, 0.f, 1366.f, 768.f));
                     clampView(view, worldbounds_);
                     currentZoom_ = 0;
                     window.setView(view);
-                    for (auto& bird : birds_) {
-                        if (!bird->isShot()) {
-                            std::cout << "new bird set to in turn" << std::endl;
-                            slingshot_.setBird(bird);
-                            bird_in_turn_ = bird;
-                            // std::cout << "sling: " << slingshot_.getX() << " " << slingshot_.getY() << std::endl;
-                            b2Vec2 newPos(slingshot_.getX()/100.0f, slingshot_.getY()/100.0f);
-                            bird_in_turn_->getBody()->SetTransform(newPos, 0);
-                            break;
-                        }
+                    if (simulation_.placeNextBird()) {
+                        std::cout << "new bird set to in turn" << std::endl;
+                        std::shared_ptr<Bird> next = simulation_.getBirdInTurn();
+                        slingshot_.setBird(next);
                     }
                 }
-                else if (bird_in_turn_ && !clicked_) {
+                else if (bird_in_turn && !clicked_) {
                     sf::Vector2i distance(globalPosition.x-slingshot_.getX(), globalPosition.y-slingshot_.getY());
                     if (length(distance) > 70) {
                         distance.x = 70 * distance.x/length(distance);
                         distance.y = 70 * distance.y/length(distance);
                     }
-                    b2Vec2 newPos((slingshot_.getX()+ distance.x)/100.0f, (slingshot_.getY() + distance.y)/100.0f);
-                    bird_in_turn_->getBody()->SetTransform(newPos, 0);
+                    simulation_.aimBird(sf::Vector2f(distance.x, distance.y));
                     dragging_ = true;
+                    preview_.begin(simulation_, *bird_in_turn);
+                    updatePreview();
                     pressPosition_ = position;
                 }
             }
@@ -269,14 +343,14 @@
         void processMouseMove(sf::RenderWindow& window, sf::View& view) {
             sf::Vector2i mousePos = sf::Mouse::getPosition(window);
             sf::Vector2f globalPos = window.mapPixelToCoords(mousePos);
-            if (bird_in_turn_ && dragging_) {
+            if (simulation_.getBirdInTurn() && dragging_) {
                 sf::Vector2i distance(globalPos.x - slingshot_.getX(), globalPos.y - slingshot_.getY());
                 if (length(distance) > 70) {
                     distance.x = 70 * distance.x/length(distance);
                     distance.y = 70 * distance.y/length(distance);
                 }
-                b2Vec2 newPos((slingshot_.getX() + distance.x) / 100.0f, (slingshot_.getY() + distance.y) / 100.0f);
-                bird_in_turn_->getBody()->SetTransform(newPos, 0);
+                simulation_.aimBird(sf::Vector2f(distance.x, distance.y));
+                updatePreview();
                 // zoom to bird when shooting
                 view.reset(sf::FloatRect(0.f, 0.f, 1366.f, 768.f));
                 view.zoom(1.0f / (1.0f + length(distance) / 1000));
@@ -301,20 +375,31 @@
          * @return An action string indicating the result of the release.
          */
         std::string processMouseButtonRelease(sf::RenderWindow& window, sf::View& view) {
-            if (bird_in_turn_ && dragging_ && !clicked_) {
+            std::shared_ptr<Bird> bird_in_turn = simulation_.getBirdInTurn();
+            if (bird_in_turn && dragging_ && !clicked_) {
                 //std::cout << position.x << " " << position.y << std::endl;
                 std::cout << "bird shot" << std::endl;
-                b2Vec2 impulse(-(bird_in_turn_->getX() - slingshot_.getX())/7.0f, -(bird_in_turn_->getY() - slingshot_.getY())/7.0f);
-                bird_in_turn_->setBodyDynamic();
-                bird_in_turn_->setVelocity(impulse);
-                bird_in_turn_->speak();
-                bird_in_turn_->fly();
-                bird_in_turn_->shoot();
+                sf::Vector2f offset(bird_in_turn->getX() - slingshot_.getX(), bird_in_turn->getY() - slingshot_.getY());
+                simulation_.launch(simulation_.getBirdInTurnIndex(), LevelSimulation::impulseFromOffset(offset));
                 dragging_ = false;
+                preview_.clear();
             }
             return "";
         }
 
+        /**
+         * @brief Recomputes the trajectory preview for the current position of the bird in the slingshot.
+         * 
+         * Uses the same impulse as processMouseButtonRelease().
+         */
+        void updatePreview() {
+            std::shared_ptr<Bird> bird_in_turn = simulation_.getBirdInTurn();
+            if (bird_in_turn) {
+                sf::Vector2f offset(bird_in_turn->getX() - slingshot_.getX(), bird_in_turn->getY() - slingshot_.getY());
+                preview_.update(bird_in_turn->GetPosition(), LevelSimulation::impulseFromOffset(offset));
+            }
+        }
+
         /**
          * @brief Controls the motion of the bird during flight.
          * 
@@ -324,8 +409,8 @@
          * @param view The SFML view to be updated.
          */
         void flyMotion(sf::RenderWindow& window, sf::View& view) {
-            if (bird_in_turn_) {
-                sf::Vector2f birdPos = bird_in_turn_->GetPosition();
+            if (std::shared_ptr<Bird> bird_in_turn = simulation_.getBirdInTurn()) {
+                sf::Vector2f birdPos = bird_in_turn->GetPosition();
                 // sf::Vector2f viewPos = view.getCenter();
                 float offset = birdPos.x - slingshot_.getX();
                 view.move(offset / 1000, 0);
@@ -419,9 +504,12 @@
         double length(sf::Vector2i v) { return sqrt(v.x * v.x + v.y * v.y); }
 
         /**
-         * @brief Updates the game state by processing physics and object positions.
+         * @brief Updates the game state by advancing the simulation.
          * 
-         * Handles the physics simulation and updates the positions of the birds, pigs, obstacles, and other game objects.
+         * When the simulation settles after the last bird or pig, the level keeps running
+         * frame by frame through the game loop until the simulation gives its verdict,
+         * with input limited to processSettlingEvent(). In fast-forward kFastForward times
+         * the elapsed time is simulated per frame while settling.
          * 
          * @param deltaTime The elapsed time since the last update.
          * @param window The SFML render window.
@@ -429,90 +517,34 @@
          * @return A pair containing the action result.
          */
         std::pair<std::string, int> update(sf::Time deltaTime, sf::RenderWindow& window, sf::View& view) override {
-            updatePhysics(deltaTime.asSeconds()); // Update the Box2D world
-            flyMotion(window, view);
-            // update object positions (SFML)
-            for (auto bird : birds_) { bird->Update(); }
-            for (auto pig : pigs_) { pig->Update(); }
-            for (auto obstacle : obstacles_) { obstacle->Update(); }
-            if (star_) { star_->Update(); }
-            if (birdsAlive() == 0) {
-                view.reset(sf::FloatRect(0.f, 0.f, 1366.f, 768.f));
-                window.setView(view);
-                sf::Clock clock;
-                sf::Time seconds = sf::seconds(5); // The game updates 5 seconds after the launch of the last bird, then checks if won or not
-                sf::Clock deltaClock;
-                // Waiting 5 seconds before winning/losing
-                while (clock.getElapsedTime() < seconds) {
-                    sf::Event event;
-                    while (window.pollEvent(event)) {
-                        switch (event.type) {
-                            case sf::Event::MouseButtonPressed: {
-                                if (bird_in_turn_) {
-                                    if (bird_in_turn_->isFlying() && !(bird_in_turn_->isSpecialActionUsed())) {
-                                        bird_in_turn_->SpecialAction();
-                                    }
-                                }
-                            }
-                            case sf::Event::MouseWheelScrolled: {
-                                processWheelScroll(event, window, view);
-                                break;
-                            }
-                            default: { break; }
-                        }
-                    }
-                    sf::Time deltatime = deltaClock.restart();
-                    updateWithOutWinCheck(deltatime);
-                    render(window, view);
-                }
-                if (pigsAlive() > 0) { return getReturn("lose"); }
-                else if (!level_empty_) { return getReturn("win"); }
-                else { return getReturn(""); }
+            float speed = settling_ && fastForward_ ? kFastForward : 1.0f;
+            simulation_.advance(deltaTime.asSeconds() * speed);
+            playSounds();
+            if (simulation_.getStatus() == SimulationStatus::Settling) {
+                if (!settling_) { beginSettling(window, view); }
             }
-            if (pigsAlive() == 0) {
-                sf::Clock clock;
-                sf::Time seconds = sf::seconds(3); // The game updates 3 seconds after the launch of the last bird, then checks if won or not
-
-                sf::Clock deltaClock;
-                // Waiting 3 seconds before winning/losing
-                while (clock.getElapsedTime() < seconds) {
-                    sf::Event event;
-                    while (window.pollEvent(event)) {
-                        switch (event.type) {
-                            case sf::Event::MouseWheelScrolled: {
-                                processWheelScroll(event, window, view);
-                                break;
-                            }
-                            default: { break; }
-                        }
-                    }
-                    sf::Time deltatime = deltaClock.restart();
-                    updateWithOutWinCheck(deltatime);
-                    render(window, view);
-                }
-                // check how many birds are left after a win and update points
-                score_ += 5000 * birdsAlive();
-                // std::cout << "score is now " << score_ + collisionListener_.getScore() << std::endl;
-                if (!level_empty_) { return getReturn("win"); }
-                else { return getReturn(""); }
+            else { flyMotion(window, view); }
+            if (dragging_) { preview_.refresh(); }
+            switch (simulation_.getStatus()) {
+                case SimulationStatus::Won: { return getReturn("win"); }
+                case SimulationStatus::Lost: { return getReturn("lose"); }
+                default: { return getReturn(""); }
             }
-            return getReturn("");
         }
 
-         /**
-         * @brief Updates the game state without checking for win conditions.
-         * 
-         * Updates the physics and object positions without checking if the level is won or lost.
+        /**
+         * @brief Enter the settling phase, the whole level is shown if every bird has been shot.
          * 
-         * @param deltaTime The elapsed time since the last update.
+         * @param window The SFML render window.
+         * @param view The SFML view to be reset.
          */
-        void updateWithOutWinCheck(sf::Time deltaTime) {
-            updatePhysics(deltaTime.asSeconds()); // Update the Box2D world
-            // update object positions (SFML)
-            for (auto bird : birds_) { bird->Update(); }
-            for (auto pig : pigs_) { pig->Update(); }
-            for (auto obstacle : obstacles_) { obstacle->Update(); }
-            if (star_) { star_->Update(); }
+        void beginSettling(sf::RenderWindow& window, sf::View& view) {
+            settling_ = true;
+            outOfBirds_ = simulation_.birdsAlive() == 0;
+            if (outOfBirds_) {
+                view.reset(sf::FloatRect(0.f, 0.f, 1366.f, 768.f));
+                window.setView(view);
+            }
         }
 
         /**
@@ -525,85 +557,22 @@
          */
         void render(sf::RenderWindow& window, sf::View& view) override {
             window.clear();
-            render_.renderBackground(window, true);
-            // Add graphic objects
-            render_.renderObstacle(window, *ground_);
-            render_.renderSlingShot(window, slingshot_);
-            if (star_) { render_.renderStar(window, *star_); }
-            // jotenkin calculatee score
-            int currentscore = collisionListener_.getScore();
-            render_.renderLevelInfo(window, pigsAlive(), birdsAlive(), currentscore);
-            for (auto bird : birds_) { render_.renderBird(window, *bird); }
-            for (auto pig : pigs_) { render_.renderPig(window, *pig); }
-            for (auto obstacle : obstacles_) { render_.renderObstacle(window, *obstacle); }
+            // background, ground and slingshot come from a texture drawn once
+            render_.renderScenery(window, *simulation_.getGround(), slingshot_);
+            // the whole world layer is drawn with one call, without what is outside the view
+            render_.beginWorld(window);
+            render_.batchTransforms(simulation_.getTransforms());
+            render_.renderWorld(window);
+            if (dragging_) {
+                sf::Vector2f impact = preview_.getImpact();
+                render_.renderTrajectory(window, preview_.getPoints(), preview_.hasImpact() ? &impact : nullptr);
+            }
+            int currentscore = simulation_.getScore();
+            render_.renderLevelInfo(window, simulation_.pigsAlive(), simulation_.birdsAlive(), currentscore);
             for (auto button : buttons_) { render_.renderButton(window, *button); }
-            if (birds_.empty() || pigs_.empty()) {
+            if (simulation_.isEmpty()) {
                 render_.renderHeading(window, "Create your level in Sandbox!", 120);
             }
-            window.display();
-        }
-
-        /**
-         * @brief Checks how many pigs are alive in the level.
-         * 
-         * @returns Integer number of pigs that are alive.
-         */
-        int pigsAlive() {
-            int sum = 0;
-            for (const auto& pig : pigs_) {
-                if (pig->getHp() > 0) {
-                    sum++;
-                }
-            }
-            return sum;
-        }
-
-        /**
-         * @brief Checks how many birds are alive in the level.
-         * 
-         * @returns Integer number of unused birds. 
-         */
-        int birdsAlive() {
-            int sum = 0;
-            for (const auto& bird : birds_) {
-                if (!(bird->isShot())) {
-                    sum++;
-                }
-            }
-            return sum;
-        }
-
-        /**
-         * @brief Updates the physics simulation of the level.
-         * 
-         * Advances the physics simulation of the Box2D world.
-         * 
-         * @param deltaTime The elapsed time since the last update.
-         */
-        void updatePhysics(double deltaTime) {
-        
-            double timeStep = 1.0f / 60.0f;
-            physicsTime_ += deltaTime;
-
-            while (physicsTime_ >= timeStep) {
-                world_.Step(timeStep, 8, 3); // Updates the b2World by 1 "step"
-                physicsTime_ -= timeStep;
-            }
-            
-            // remove destroyed objects from the b2 world
-            const auto& bodiesToRemove = collisionListener_.getBodiesToRemove();
-            for (b2Body* body : bodiesToRemove) {
-                Userdata* data = reinterpret_cast<Userdata*>(body->GetUserData().pointer);
-                if (data) {
-                    if (data->object) {
-                        // std::cout << data->objecttype << "data deleted" << std::endl;
-                        delete data; // userdata object have object attributes that need to be freed.
-                        world_.DestroyBody(body);
-                        // std::cout << "body destroyed" << std::endl;
-                    }
-                }
-            }
-            collisionListener_.clearBodiesToRemove();
         }
 
         /**
@@ -615,28 +584,27 @@
 
     private:
         int level_number_;
-        b2Vec2 gravity_;
-        b2World world_;
-        std::shared_ptr<Bird> bird_in_turn_;
+        LevelSimulation simulation_;
         Scores highscores_;
         Slingshot slingshot_;
         std::vector<std::shared_ptr<Button>> buttons_;
-        std::vector<std::shared_ptr<Bird>> birds_;
-        std::vector<std::shared_ptr<Pig>> pigs_;
-        std::vector<std::shared_ptr<Obstacle>> obstacles_;
-        std::shared_ptr<Ground> ground_;
         bool dragging_ = false;
-        double physicsTime_ = 0;
+        bool settling_ = false;         // waiting for the verdict, see beginSettling()
+        bool fastForward_ = false;      // simulate the settling faster than real time
+        static constexpr float kFastForward = 4.0f;     // speed of the fast-forward, within the steps per frame of the simulation
+        bool outOfBirds_ = false;       // settling because every bird has been shot
         std::shared_ptr<Button> buttonClicked_;
         bool clicked_ = false;
         sf::Vector2i pressPosition_; // To store the position of mouse press
-        int score_;
         sf::FloatRect worldbounds_ = sf::FloatRect(0, 0, 1366, 768);
-        std::shared_ptr<Star> star_;
-        CollisionListener collisionListener_;
-        sf::Clock clockForWorld_;
-        bool level_empty_;
         Render render_;
+        TrajectoryPreview preview_;
         int currentZoom_;
         sf::Music music_;
+        struct ObjectSound {
+            std::shared_ptr<sf::SoundBuffer> buffer;
+            int priority;
+        };
+        std::map<const Object*, ObjectSound> sounds_;   // sound of each object of the simulation
+        VoicePool voices_;                              // plays the sounds of all objects, declared after sounds_ so it stops before the buffers are freed
     };
@@ -1,10 +1,32 @@
 #include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <string>
 
 #include "game.hpp"
 
 
-int main(void) {
+int main(int argc, char* argv[]) {
     Game game;
+    // ANGRY_BIRDS_TRACE=<file> records a timeline like --trace <file>
+    if (const char* trace = std::getenv("ANGRY_BIRDS_TRACE")) {
+        game.traceToFile(trace);
+    }
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        // --profile-csv <file> writes the time and counters of every frame to a CSV file
+        if (arg == "--profile-csv" && i + 1 < argc) {
+            game.profileToCsv(argv[++i]);
+        }
+        // --trace <file> writes a Chrome trace of the whole run when the window is closed
+        else if (arg == "--trace" && i + 1 < argc) {
+            game.traceToFile(argv[++i]);
+        }
+        else {
+            std::cerr << "usage: " << argv[0] << " [--profile-csv <file>] [--trace <file>]" << std::endl;
+            return 1;
+        }
+    }
     game.run();
     
     return 0;
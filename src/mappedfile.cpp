@@ -0,0 +1,83 @@
+#include "mappedfile.hpp"
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed opening the file " + path + "!");
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw std::runtime_error("Failed reading the size of " + path + "!");
+    }
+    file_ = file;
+    size_ = static_cast<std::size_t>(size.QuadPart);
+    if (size_ == 0) {
+        return;  // an empty file cannot be mapped, data() stays nullptr
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        throw std::runtime_error("Failed mapping the file " + path + "!");
+    }
+    mapping_ = mapping;
+    data_ = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data_) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::runtime_error("Failed mapping the file " + path + "!");
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (data_) { UnmapViewOfFile(data_); }
+    if (mapping_) { CloseHandle(mapping_); }
+    if (file_) { CloseHandle(file_); }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed opening the file " + path + "!");
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("Failed reading the size of " + path + "!");
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ > 0) {
+        void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Failed mapping the file " + path + "!");
+        }
+        data_ = static_cast<const unsigned char*>(data);
+    }
+    close(fd);  // the mapping stays valid after closing the descriptor
+}
+
+MappedFile::~MappedFile() {
+    if (data_) {
+        munmap(const_cast<unsigned char*>(data_), size_);
+    }
+}
+
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The contents are paged in by the operating system on first access, so nothing
+ * is copied or parsed up front. The mapping is released when the object is destroyed.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Map the given file into memory.
+     *
+     * @param path Path to the file.
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string& path);
+
+    /**
+     * @brief Unmap the file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Get a pointer to the first byte of the file.
+     */
+    const unsigned char* data() const { return data_; }
+
+    /**
+     * @brief Get the size of the file in bytes.
+     */
+    std::size_t size() const { return size_; }
+
+private:
+    const unsigned char* data_ = nullptr;   // Start of the mapping, nullptr for an empty file
+    std::size_t size_ = 0;                  // Size of the file in bytes
+#ifdef _WIN32
+    void* file_ = nullptr;                  // Windows file handle
+    void* mapping_ = nullptr;               // Windows file mapping handle
+#endif
+};
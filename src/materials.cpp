@@ -0,0 +1,62 @@
+#include "materials.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    const char* kNames[] = { "Wood", "Stone", "Glass", "Pig", "King", "Star", "Red", "Yellow", "Ground" };
+}
+
+Materials::Materials(const std::string& path) {
+    std::ifstream ifs(path);
+    if (!ifs) {
+        throw std::runtime_error("Failed opening the file " + path + "!");
+    }
+    std::string line;
+    std::string item;
+    while (std::getline(ifs, line)) {
+        // "name resistance damage" per line
+        if (line == "Materials") {
+            while (std::getline(ifs, item) && item != "") {
+                std::istringstream iss(item);
+                std::string name;
+                float resistance, damage;
+                if (!(iss >> name >> resistance >> damage) || fromName(name) == Material::Count) {
+                    throw std::runtime_error("Corrupted materials file at Materials!");
+                }
+                MaterialProperties& properties = table_[static_cast<std::size_t>(fromName(name))];
+                properties.resistance = resistance;
+                properties.damage = damage;
+            }
+        }
+        // "name multiplier" per line
+        else if (line == "Birds") {
+            while (std::getline(ifs, item) && item != "") {
+                std::istringstream iss(item);
+                std::string name;
+                float multiplier;
+                if (!(iss >> name >> multiplier) || fromName(name) == Material::Count) {
+                    throw std::runtime_error("Corrupted materials file at Birds!");
+                }
+                table_[static_cast<std::size_t>(fromName(name))].multiplier = multiplier;
+            }
+        }
+        else if (line != "") {
+            throw std::runtime_error("Corrupted materials file!");
+        }
+    }
+}
+
+const Materials& Materials::getDefault() {
+    static const Materials materials(kDefaultPath);
+    return materials;
+}
+
+Material Materials::fromName(const std::string& name) {
+    for (std::size_t i = 0; i < static_cast<std::size_t>(Material::Count); i++) {
+        if (name == kNames[i]) {
+            return static_cast<Material>(i);
+        }
+    }
+    return Material::Count;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief What an Object is made of, selects its row of the material table.
+ */
+enum class Material : std::uint8_t {
+    Wood,
+    Stone,
+    Glass,
+    Pig,
+    King,
+    Star,
+    Red,
+    Yellow,
+    Ground,
+    Count       // number of materials, not a material
+};
+
+/**
+ * @brief How a material takes impact damage and how hard it hits.
+ */
+struct MaterialProperties {
+    float resistance = 0;       // impulse in N*s per physics step absorbed without damage
+    float damage = 0;           // hp lost per N*s of impulse above the resistance
+    float multiplier = 1;       // scales the impulse a bird of this material deals to others
+};
+
+/**
+ * @class Materials
+ * @brief Damage table of all materials, read from a text file.
+ *
+ * The file has a "Materials" section with "name resistance damage" per line and a
+ * "Birds" section with "name multiplier" per line, each ended by an empty line.
+ * Materials that are not in the file take no damage.
+ */
+class Materials {
+public:
+    /**
+     * @brief Read a material table.
+     *
+     * @param path Path of the text file.
+     * @throws std::runtime_error if the file cannot be opened or is corrupted.
+     */
+    explicit Materials(const std::string& path);
+
+    /**
+     * @brief Get the table of the game, read from kDefaultPath on the first call.
+     */
+    static const Materials& getDefault();
+
+    /**
+     * @brief Get the properties of a material.
+     */
+    const MaterialProperties& operator[](Material material) const { return table_[static_cast<std::size_t>(material)]; }
+
+    /**
+     * @brief Find a material by its name in the file, e.g. "Wood".
+     *
+     * @return Material::Count if there is no such material.
+     */
+    static Material fromName(const std::string& name);
+
+    static constexpr const char* kDefaultPath = "../src/textfiles/materials.txt";
+
+private:
+    std::array<MaterialProperties, static_cast<std::size_t>(Material::Count)> table_;
+};
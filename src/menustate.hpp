@@ -219,8 +219,6 @@ public:
         }
         render_.renderButton(window, *volumeSlide_);
         render_.renderButton(window, *volumeKnob_);
-
-        window.display();
     }
 
 private:
@@ -83,7 +83,6 @@ public:
         render_.renderBackground(window, false);
         render_.renderInputBox(window, *inputbox_);
         render_.renderButton(window, *button_);
-        window.display();
     }
 
     /**
@@ -1,25 +1,12 @@
 #include "object.hpp"
-#include <SFML/Audio.hpp>
+#include <cmath>
 #include <iostream>
 
 
 Object::Object(int initialHp, double x, double y, double width, double height, const std::string& soundFilePath, const std::string& textureFilePath,
            double density, double friction, double restitution)
-        : hp_(initialHp), destroyed_(false), width_(width), height_(height), position_(sf::Vector2f(x, y))
+        : hp_(initialHp), destroyed_(false), width_(width), height_(height), soundFilePath_(soundFilePath), position_(sf::Vector2f(x, y)), textureFilePath_(textureFilePath)
 {
-    // get texture from file
-    if (!texture_.loadFromFile(textureFilePath)) {
-        throw std::runtime_error("Error loading texture file: " + textureFilePath + "!");
-    }
-
-    // get sound from file
-    if (!soundBuffer_.loadFromFile(soundFilePath)) {
-        throw std::runtime_error("Error loading sound file: " + soundFilePath + "!");
-    }
-    sound_.setBuffer(soundBuffer_);
-    sound_.setVolume(40);
-
-    createSprite();
     setPhysicsProperties(density, friction, restitution);   // Set the object's physical properties
     bodyDef_.position.Set(x / 100, y / 100);                // Set position and other attributes, Convert to Box2D unit
 }
@@ -32,23 +19,17 @@ void Object::takeDamage(int amount) {
     }
 }
 
-void Object::speak() {
-    sound_.play();
-}
-
-void Object::createSprite() {
-    sprite_.setTexture(texture_);
-
-    sf::FloatRect bounds = sprite_.getLocalBounds();
-    sprite_.setOrigin(bounds.width / 2, bounds.height / 2);
-
-    float texture_x = static_cast<float>(texture_.getSize().x);
-    float texture_y = static_cast<float>(texture_.getSize().y);
-    float x_scale = width_ / texture_x;
-    float y_scale = height_ / texture_y;
-
-    sprite_.setScale(x_scale, y_scale);
-    sprite_.setPosition(getX(), getY());
+bool Object::containsPoint(sf::Vector2f point) const {
+    if (body_) {
+        b2Vec2 worldPoint(point.x / 100, point.y / 100);   // Convert to Box2D unit
+        for (const b2Fixture* fixture = body_->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+            if (fixture->TestPoint(worldPoint)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    return std::abs(point.x - getX()) <= width_ / 2 && std::abs(point.y - getY()) <= height_ / 2;
 }
 
 void Object::setShapeRectangle() {
@@ -64,3 +45,63 @@ void Object::setShapeCircle() {
     circleShape_.m_radius = width_/200.0f;
     fixtureDef_.shape = &circleShape_;
 }
+
+
+void Object::saveInitialState() {
+    initialState_.hp = hp_;
+    initialState_.destroyed = destroyed_;
+    initialState_.flying = flying_;
+    initialState_.speakCount = speakCount_;
+    if (body_) {
+        initialState_.transform = body_->GetTransform();
+        initialState_.linearVelocity = body_->GetLinearVelocity();
+        initialState_.angularVelocity = body_->GetAngularVelocity();
+        initialState_.type = body_->GetType();
+        initialState_.awake = body_->IsAwake();
+        initialState_.enabled = body_->IsEnabled();
+        initialState_.fixedRotation = body_->IsFixedRotation();
+    }
+}
+
+void Object::restoreInitialState() {
+    hp_ = initialState_.hp;
+    destroyed_ = initialState_.destroyed;
+    pendingRemoval_ = false;
+    flying_ = initialState_.flying;
+    speakCount_ = initialState_.speakCount;
+    if (body_) {
+        // type and fixed rotation reset the velocities, so they are set first
+        body_->SetType(initialState_.type);
+        body_->SetFixedRotation(initialState_.fixedRotation);
+        setTransform(initialState_.transform.p, initialState_.transform.q.GetAngle());
+        body_->SetLinearVelocity(initialState_.linearVelocity);
+        body_->SetAngularVelocity(initialState_.angularVelocity);
+        body_->SetEnabled(initialState_.enabled);
+        body_->SetAwake(initialState_.awake);
+    }
+    Update();
+}
+
+void Object::Update(float alpha) {
+    if (!body_) {
+        return;
+    }
+    if (transforms_) {
+        transforms_->store(transformSlot_, *body_);
+    }
+    else {
+        interpolateTransform(alpha);
+    }
+}
+
+void Object::interpolateTransform(float alpha) {
+    b2Vec2 position = body_->GetPosition();
+    float angle = body_->GetAngle();
+    if (hasPrevious_) {
+        position = alpha * position + (1.0f - alpha) * previousPosition_;
+        angle = alpha * angle + (1.0f - alpha) * previousAngle_;
+    }
+    setX(position.x * 100.0f);  // Convert meters to pixels
+    setY(position.y * 100.0f);
+    angle_ = angle * 180.0f / b2_pi;  // Convert radians to degrees
+}
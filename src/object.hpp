@@ -1,15 +1,40 @@
 #pragma once
 
 #include <string>
-#include <SFML/Graphics.hpp>
-#include <SFML/Audio.hpp>
+#include <memory>
+#include <SFML/System/Vector2.hpp>
 #include <box2d/box2d.h>
+#include "userdata.hpp"
+#include "materials.hpp"
+#include "transformbuffer.hpp"
+
+/**
+ * @brief Saved state of an Object and its Box2D body.
+ * 
+ * Captured when a level has been built so that the level can be reset in place
+ * instead of being constructed again.
+ */
+struct ObjectState {
+    b2Transform transform;              // position and rotation of the body
+    b2Vec2 linearVelocity;
+    float angularVelocity = 0;
+    b2BodyType type = b2_staticBody;
+    bool awake = false;
+    bool enabled = false;
+    bool fixedRotation = false;
+    int hp = 0;
+    bool destroyed = false;
+    bool flying = false;
+    int speakCount = 0;
+};
 
 /**
  * @brief Parent class for bird, pig, and obstacle classes.
  * 
- * This class serves as a base for all interactive objects in the game. It combines
- * physical properties, graphical representation, and sound effects.
+ * This class serves as a base for all interactive objects in the game. It holds the
+ * physical properties and the paths of the texture and sound of the object. Drawing
+ * and playing sounds is left to the game states, so objects can be simulated without
+ * a window or an audio device.
  * 
  */
 
@@ -19,7 +44,7 @@ class Object {
         /**
          * @brief Constructor to initialize an Object in the game.
          * 
-         * Creates an object with specific physical and graphical properties, positioning it 
+         * Creates an object with specific physical properties, positioning it 
          * in the game and associating it with texture and sound assets.
          * 
          * @param initialHp Initial health points of the Object.
@@ -56,7 +81,7 @@ class Object {
          * 
          * @return Boolean value 'true' if the Object is destroyed, 'false' otherwise.
          */
-        bool isDestroyed() { return destroyed_; }
+        bool isDestroyed() const { return destroyed_; }
 
         /**
          * @brief Destroy the Object.
@@ -66,23 +91,65 @@ class Object {
         void destroy() { destroyed_ = true; }
 
         /**
-         * @brief Get the current health points of the Object.
+         * @brief Mark the Object to be removed from the physics world after the current step.
          * 
-         * @return int The health points of the Object.
+         * @return true if the Object was not marked already, then it should be queued.
+         */
+        bool markForRemoval() {
+            if (pendingRemoval_) {
+                return false;
+            }
+            pendingRemoval_ = true;
+            return true;
+        }
+
+        /**
+         * @brief Check if the Object waits to be removed from the physics world.
+         */
+        bool isPendingRemoval() const { return pendingRemoval_; }
+
+        /**
+         * @brief Get the place of the Object in the AwakeSet of its level, -1 if it is not in the set.
+         */
+        int getAwakeIndex() const { return awakeIndex_; }
+
+        void setAwakeIndex(int index) { awakeIndex_ = index; }
+
+        /**
+         * @brief Get the order of the Object among the objects of its kind when drawn, higher is drawn on top.
          */
-        int getHp() { return hp_; }
+        unsigned getDrawOrder() const { return drawOrder_; }
+
+        void setDrawOrder(unsigned order) { drawOrder_ = order; }
 
         /**
-         * @brief Play the sound associated with the Object.
+         * @brief Get the material of the Object, it decides how the Object takes impact damage.
          */
-        void speak();
+        Material getMaterial() const { return material_; }
+
+        /**
+         * @brief Get the handle of the Object in the table of its level.
+         */
+        ObjectHandle getHandle() const { return userdata_.handle; }
+
+        /**
+         * @brief Set the handle of the Object, it is also reachable from the body's userdata.
+         */
+        void setHandle(ObjectHandle handle) { userdata_.handle = handle; }
+
+        /**
+         * @brief Get the current health points of the Object.
+         * 
+         * @return int The health points of the Object.
+         */
+        int getHp() const { return hp_; }
 
         /**
          * @brief Get the number of times the Object has "spoken."
          * 
          * @return int The speak count.
          */
-        int getSpeakCount() { return speakCount_; }
+        int getSpeakCount() const { return speakCount_; }
 
         /**
          * @brief Increment the speak count.
@@ -96,26 +163,91 @@ class Object {
          * 
          * @return sf::Vector2f The position of the Object as a 2D vector.
          */
-        sf::Vector2f GetPosition() { return position_; }
+        sf::Vector2f GetPosition() { return sf::Vector2f(getX(), getY()); }
 
         /**
-         * @brief Create the graphical sprite for the Object.
+         * @brief Get the rotation of the Object.
+         * 
+         * @return float The rotation in degrees, clockwise.
          */
-        void createSprite();
+        float getAngle() const { return transforms_ ? transforms_->getAngle()[transformSlot_] : angle_; }
 
         /**
-         * @brief Get the sprite representing the Object.
+         * @brief Get the path of the texture file of the Object.
+         * 
+         * Used as the key of the Object's image in the texture atlas.
          * 
-         * @return sf::Sprite& A reference to the sprite.
+         * @return const std::string& The texture file path.
          */
-        sf::Sprite& getSprite() { return sprite_; }
+        const std::string& getTextureFilePath() const { return textureFilePath_; }
+
+        /**
+         * @brief Get the path of the sound file of the Object.
+         * 
+         * @return const std::string& The sound file path.
+         */
+        const std::string& getSoundFilePath() const { return soundFilePath_; }
+
+        /**
+         * @brief Check if a point of the world is inside the Object.
+         * 
+         * Tests the shape of the Box2D body, or the rectangle of the Object if it has no body yet.
+         * 
+         * @param point The point in pixels.
+         * @return Boolean value 'true' if the point is inside the Object, 'false' otherwise.
+         */
+        bool containsPoint(sf::Vector2f point) const;
         
         /**
-         * @brief Update the graphics Object's position (pure virtual function).
+         * @brief Update the drawn position and rotation of the Object from its body.
          * 
-         * Must be implemented by derived classes to handle specific update logic.
+         * With a TransformBuffer the body is only copied into the slot of the Object,
+         * the buffer interpolates and converts every slot at once in toPixels().
+         * 
+         * @param alpha How far to draw the Object between its transform before the last
+         *              physics step (0) and its current transform (1).
+         */
+        virtual void Update(float alpha = 1.0f);
+
+        /**
+         * @brief Remember the transform of the body before a physics step, for Update(alpha).
          */
-        virtual void Update() = 0;
+        void savePreviousTransform() {
+            if (body_) {
+                if (transforms_) {
+                    transforms_->savePrevious(transformSlot_, *body_);
+                    return;
+                }
+                previousPosition_ = body_->GetPosition();
+                previousAngle_ = body_->GetAngle();
+                hasPrevious_ = true;
+            }
+        }
+
+        /**
+         * @brief Draw the Object with a slot of a TransformBuffer instead of its own position.
+         * 
+         * @param buffer The buffer, nullptr to detach.
+         * @param slot The slot of the Object in the buffer.
+         */
+        void setTransformSlot(TransformBuffer* buffer, int slot) {
+            transforms_ = buffer;
+            transformSlot_ = slot;
+        }
+
+        /**
+         * @brief Move the body without interpolating from where it was.
+         * 
+         * @param position The new position in Box2D units (meters).
+         * @param angle The new rotation in radians.
+         */
+        void setTransform(b2Vec2 position, float angle) {
+            body_->SetTransform(position, angle);
+            if (transforms_) {
+                transforms_->place(transformSlot_, *body_);
+            }
+            savePreviousTransform();
+        }
 
         /**
          * @brief Center the origin of the Object for transformations.
@@ -130,14 +262,14 @@ class Object {
          * 
          * @return float The X-coordinate.
          */
-        float getX() const { return position_.x; }
+        float getX() const { return transforms_ ? transforms_->getX()[transformSlot_] : position_.x; }
 
         /**
          * @brief Get the Y-coordinate of the Object.
          * 
          * @return float The Y-coordinate.
          */
-        float getY() const { return position_.y; }
+        float getY() const { return transforms_ ? transforms_->getY()[transformSlot_] : position_.y; }
 
         /**
          * @brief Set the X-coordinate of the Object.
@@ -340,12 +472,26 @@ class Object {
          */
         void applyImpulse(b2Vec2 impulse) { body_->ApplyLinearImpulse(impulse, body_->GetPosition(), true); };
 
+        /**
+         * @brief Save the current state of the Object and its body as the initial state.
+         * 
+         * Called once the level has been built, restoreInitialState() returns to this state.
+         */
+        virtual void saveInitialState();
+
+        /**
+         * @brief Reset the Object and its body to the saved initial state.
+         * 
+         * The body is reused, so nothing is allocated or reloaded.
+         */
+        virtual void restoreInitialState();
+
         /**
          * @brief Check if the Object is flying.
          * 
          * @return Boolean value 'true' if flying, 'false' otherwise.
          */
-        bool isFlying() { return flying_; }
+        bool isFlying() const { return flying_; }
 
         /**
          * @brief Set the Object to a flying state.
@@ -362,25 +508,57 @@ class Object {
     protected:
         int hp_;                           // initial health points
         bool destroyed_ = false;           // Used to track if object is destroyed
+        bool pendingRemoval_ = false;      // queued for removal from the physics world
+        int awakeIndex_ = -1;              // place in the AwakeSet, -1 if not in it
+        TransformBuffer* transforms_ = nullptr;  // holds the drawn transform if set
+        int transformSlot_ = -1;           // slot in transforms_
+        unsigned drawOrder_ = 0;           // used by ObjectPicker to find the topmost object
+        Material material_ = Material::Wood;  // set by the constructor of each type
         double originX_, originY_;         // center of the object
         double width_, height_;            // width and height of the object
         bool flying_ = false;
         int speakCount_ = 0;                                     
 
-        sf::SoundBuffer soundBuffer_;     // Sound buffer holding sound data
-        sf::Sound sound_;                 // Sound object used to play the sound
+        std::string soundFilePath_;       // Path of the sound played when the object is hit
 
         sf::Vector2f position_;           // The position where the object is at
-        sf::Texture texture_;             // Texture on gui
-        sf::Sprite sprite_;
+        float angle_ = 0;                 // Rotation of the object in degrees
+        std::string textureFilePath_;     // Path of the texture, key of the object's image in the texture atlas
 
-        b2Body* body_;
+        b2Body* body_ = nullptr;
         b2BodyDef bodyDef_;
         b2FixtureDef fixtureDef_;
 
         b2CircleShape circleShape_;
         b2PolygonShape rectangleShape_;
 
+        ObjectState initialState_;        // state saved by saveInitialState()
+
+        Userdata userdata_;               // attached to body_, see attachUserdata()
+
+        /**
+         * @brief Fill the userdata of the Object for its Box2D body.
+         * 
+         * @param type The type the collision listener sees.
+         * @return Value for the pointer of the body's user data.
+         */
+        uintptr_t attachUserdata(ObjectType type) {
+            userdata_.object = this;
+            userdata_.type = type;
+            return reinterpret_cast<uintptr_t>(&userdata_);
+        }
+
+        b2Vec2 previousPosition_;         // body transform before the last physics step
+        float previousAngle_ = 0;
+        bool hasPrevious_ = false;
+
+        /**
+         * @brief Set position_ and angle_ between the previous and the current transform of the body.
+         * 
+         * @param alpha 0 for the previous transform, 1 for the current one.
+         */
+        void interpolateTransform(float alpha);
+
 
           
 };
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class Object;
+
+/**
+ * @brief Reference to an Object that knows when the Object is gone.
+ *
+ * A handle is a slot of an ObjectHandles table and the generation of the slot when the
+ * handle was made. Removing the Object bumps the generation, so old handles of the slot
+ * no longer resolve even after the slot is reused.
+ */
+struct ObjectHandle {
+    static constexpr std::uint32_t kInvalid = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t index = kInvalid;
+    std::uint32_t generation = 0;
+
+    bool operator==(const ObjectHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const ObjectHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * @class ObjectHandles
+ * @brief Table of the live objects of a level, adding, removing and resolving in constant time.
+ */
+class ObjectHandles {
+public:
+    /**
+     * @brief Add an object to the table.
+     *
+     * @return Handle of the object, a removed slot is reused if there is one.
+     */
+    ObjectHandle add(Object* object) {
+        std::uint32_t index;
+        if (!free_.empty()) {
+            index = free_.back();
+            free_.pop_back();
+        }
+        else {
+            index = static_cast<std::uint32_t>(slots_.size());
+            slots_.push_back(Slot());
+        }
+        slots_[index].object = object;
+        return ObjectHandle{ index, slots_[index].generation };
+    }
+
+    /**
+     * @brief Remove an object, its handles stop resolving.
+     *
+     * @return false if the handle was already stale.
+     */
+    bool remove(ObjectHandle handle) {
+        if (!get(handle)) {
+            return false;
+        }
+        Slot& slot = slots_[handle.index];
+        slot.object = nullptr;
+        slot.generation++;
+        free_.push_back(handle.index);
+        return true;
+    }
+
+    /**
+     * @brief Resolve a handle.
+     *
+     * @return The object, nullptr if it has been removed.
+     */
+    Object* get(ObjectHandle handle) const {
+        if (handle.index >= slots_.size() || slots_[handle.index].generation != handle.generation) {
+            return nullptr;
+        }
+        return slots_[handle.index].object;
+    }
+
+    /**
+     * @brief Remove every object, all handles made so far stop resolving.
+     */
+    void clear() {
+        free_.clear();
+        for (std::uint32_t i = static_cast<std::uint32_t>(slots_.size()); i > 0; i--) {
+            slots_[i - 1].object = nullptr;
+            slots_[i - 1].generation++;
+            free_.push_back(i - 1);   // slot 0 is reused first
+        }
+    }
+
+private:
+    struct Slot {
+        Object* object = nullptr;
+        std::uint32_t generation = 0;
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<std::uint32_t> free_;   // indices of removed slots
+};
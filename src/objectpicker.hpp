@@ -0,0 +1,74 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <box2d/box2d.h>
+#include "object.hpp"
+#include "userdata.hpp"
+
+/**
+ * @class ObjectPicker
+ * @brief Finds the topmost object under a point of a Box2D world.
+ *
+ * The candidates come from b2World::QueryAABB, which walks the broad-phase tree of the
+ * world, so a click costs O(log n) plus the few fixtures around the point instead of a
+ * test against every object. Of the fixtures that contain the point, the one drawn last
+ * wins: the star is drawn first, then birds, pigs and obstacles, each kind in its draw order.
+ * The ground is never picked.
+ */
+class ObjectPicker : public b2QueryCallback {
+public:
+    /**
+     * @brief Get the topmost object under a point.
+     *
+     * @param world The world to search.
+     * @param point The point in pixels.
+     * @return nullptr if there is no object under the point.
+     */
+    Object* pick(const b2World& world, sf::Vector2f point) {
+        point_ = b2Vec2(point.x / 100, point.y / 100);  // Convert to Box2D unit
+        best_ = nullptr;
+        b2AABB box;
+        box.lowerBound = point_ - b2Vec2(kQueryMargin, kQueryMargin);
+        box.upperBound = point_ + b2Vec2(kQueryMargin, kQueryMargin);
+        world.QueryAABB(this, box);
+        return best_;
+    }
+
+    /**
+     * @brief Called by QueryAABB for each fixture whose bounding box overlaps the point.
+     */
+    bool ReportFixture(b2Fixture* fixture) override {
+        Userdata* data = reinterpret_cast<Userdata*>(fixture->GetBody()->GetUserData().pointer);
+        if (!data || !data->object || data->type == ObjectType::Ground || !fixture->TestPoint(point_)) {
+            return true;
+        }
+        int layer = drawLayer(data->type);
+        unsigned order = data->object->getDrawOrder();
+        if (!best_ || layer > bestLayer_ || (layer == bestLayer_ && order > bestOrder_)) {
+            best_ = data->object;
+            bestLayer_ = layer;
+            bestOrder_ = order;
+        }
+        return true;    // keep looking for one on top
+    }
+
+private:
+    static constexpr float kQueryMargin = 0.001f;     // half size of the queried box in meters
+
+    /**
+     * @brief Get when a type of object is drawn, higher is drawn later.
+     */
+    static int drawLayer(ObjectType type) {
+        switch (type) {
+            case ObjectType::Star: { return 0; }
+            case ObjectType::Bird: { return 1; }
+            case ObjectType::Pig: { return 2; }
+            default: { return 3; }
+        }
+    }
+
+    b2Vec2 point_;
+    Object* best_ = nullptr;
+    int bestLayer_ = 0;
+    unsigned bestOrder_ = 0;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+/**
+ * @class ObjectPool
+ * @brief Arena the objects of one level are allocated from.
+ *
+ * Objects are placed one after another in blocks of a monotonic buffer, together with the
+ * control blocks of their shared pointers. Freeing a single object does nothing; the whole
+ * arena is released at once when the level and the last object made from it are gone.
+ * A pool is not thread safe, every level has its own.
+ */
+class ObjectPool {
+public:
+    /**
+     * @brief Allocator that hands out memory of a pool and keeps the pool alive.
+     *
+     * Stored by std::allocate_shared in the control block of each object, so the arena
+     * outlives every shared pointer made from it.
+     */
+    template <typename T>
+    struct Allocator {
+        using value_type = T;
+
+        explicit Allocator(std::shared_ptr<ObjectPool> pool) : pool_(std::move(pool)) {}
+
+        template <typename U>
+        Allocator(const Allocator<U>& other) : pool_(other.pool_) {}
+
+        T* allocate(std::size_t n) {
+            return static_cast<T*>(pool_->resource_.allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, std::size_t) {}     // released with the whole arena
+
+        template <typename U>
+        bool operator==(const Allocator<U>& other) const { return pool_ == other.pool_; }
+
+        template <typename U>
+        bool operator!=(const Allocator<U>& other) const { return pool_ != other.pool_; }
+
+        std::shared_ptr<ObjectPool> pool_;
+    };
+
+    /**
+     * @brief Construct a pool.
+     *
+     * @param bytes Size of the first block, enough for a whole level avoids any further block.
+     */
+    explicit ObjectPool(std::size_t bytes = 4096) : resource_(bytes) {}
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /**
+     * @brief Create an object in a pool.
+     *
+     * @param pool The pool to allocate from.
+     * @param args Arguments of the constructor of T.
+     * @return Shared pointer to the object, it keeps the pool alive.
+     */
+    template <typename T, typename... Args>
+    static std::shared_ptr<T> make(const std::shared_ptr<ObjectPool>& pool, Args&&... args) {
+        return std::allocate_shared<T>(Allocator<T>(pool), std::forward<Args>(args)...);
+    }
+
+private:
+    std::pmr::monotonic_buffer_resource resource_;
+};
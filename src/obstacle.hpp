@@ -3,7 +3,7 @@
 #include "object.hpp"
 #include <string>
 #include <box2d/box2d.h>
-#include <userdata.hpp>
+#include "userdata.hpp"
 #include <iostream>
 
 /**
@@ -42,26 +42,6 @@ class Obstacle : public Object {
          */
         virtual ~Obstacle() {};
 
-        /**
-         * @brief Updates the obstacle's position and rotation based on physics simulation.
-         * 
-         * Synchronizes the graphical representation of the obstacle with its physics body.
-         */
-        void Update() {
-            if (body_)
-            {
-                b2Vec2 position = body_->GetPosition();
-                double angle = body_->GetAngle();
-
-                setX(position.x * 100.0f);
-                setY(position.y * 100.0f);
-
-                // Convert the position from Box2D units to SFML pixels
-                sprite_.setPosition(position.x * 100.0f, position.y * 100.0f);  // Convert meters to pixels
-                sprite_.setRotation(angle * 180.0f / b2_pi);  // Convert radians to degrees
-            }
-        }
-
         /**
          * @brief Initializes the physics world for the obstacle.
          * 
@@ -71,28 +51,11 @@ class Obstacle : public Object {
          * @throws std::runtime_error if the fixture shape is not set before creation.
          */
         void initializePhysicsWorld(b2World &world) {
-            auto* data = new Userdata;
-            data->object = this;
-            data->objecttype = "obstacle";
             body_ = world.CreateBody(&bodyDef_);
-            body_->GetUserData().pointer = reinterpret_cast<uintptr_t>(data);
+            body_->GetUserData().pointer = attachUserdata(ObjectType::Obstacle);
             if (!fixtureDef_.shape) {
                 throw std::runtime_error("Fixture shape not set before creating the fixture");
             }
             body_->CreateFixture(&fixtureDef_);
         }
-
-        /**
-         * @brief Checks if a given position is within the bounds of the obstacle's sprite.
-         * 
-         * @param position The mouse position in window coordinates.
-         * @param window The SFML window used to map pixel coordinates to world coordinates.
-         * @return Boolean value 'true' if the position is within the obstacle's bounds, 'false' otherwise.
-         */
-        bool inBounds(sf::Vector2i position, sf::RenderWindow& window) {
-            sf::Vector2f globalPosition = window.mapPixelToCoords(position);
-            sf::FloatRect bounds = getSprite().getGlobalBounds();
-            bounds.contains(globalPosition);
-            return bounds.contains(globalPosition);
-        }
 };
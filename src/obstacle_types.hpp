@@ -17,7 +17,7 @@ public:
      * soundFilePath, textureFilePath, density, friction and restitution.
      * The attributes described more specific in obstacle.hpp.
      */
-    GlassObstacle (double x, double y) : Obstacle (8, x, y, 10, 40, "../src/soundfiles/glass.wav", "../src/imagefiles/glass.png", 1, 1, 0.1) {}
+    GlassObstacle (double x, double y) : Obstacle (8, x, y, 10, 40, "../src/soundfiles/glass.wav", "../src/imagefiles/glass.png", 1, 1, 0.1) { material_ = Material::Glass; }
 
     /**
      * @brief Destructor for the GlassObstacle.
@@ -40,7 +40,7 @@ public:
      * soundFilePath, textureFilePath, density, friction and restitution.
      * The attributes described more specific in obstacle.hpp.
      */
-    StoneObstacle (double x, double y) : Obstacle (50, x, y, 30, 30, "../src/soundfiles/stone.wav", "../src/imagefiles/stone.png", 2, 1, 0.1) {}
+    StoneObstacle (double x, double y) : Obstacle (50, x, y, 30, 30, "../src/soundfiles/stone.wav", "../src/imagefiles/stone.png", 2, 1, 0.1) { material_ = Material::Stone; }
 
     /**
      * @brief Destructor for the StoneObstacle.
@@ -63,7 +63,7 @@ public:
      * soundFilePath, textureFilePath, density, friction and restitution.
      * The attributes described more specific in obstacle.hpp.
      */
-    WoodObstacle (double x, double y) : Obstacle (20, x, y, 60, 10, "../src/soundfiles/wood.wav", "../src/imagefiles/wood.png", 1.5, 1, 0.1) {}
+    WoodObstacle (double x, double y) : Obstacle (20, x, y, 60, 10, "../src/soundfiles/wood.wav", "../src/imagefiles/wood.png", 1.5, 1, 0.1) { material_ = Material::Wood; }
 
     /**
      * @brief Destructor for the StoneObstacle.
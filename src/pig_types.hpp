@@ -4,12 +4,12 @@
 
 class NormalPig : public Pig {
 public:
-    NormalPig (double x, double y) : Pig (20, x, y, 30.0, 30.0, "../src/soundfiles/pig.wav", "../src/imagefiles/pig.png",  1, 1, 0.1) {}
+    NormalPig (double x, double y) : Pig (20, x, y, 30.0, 30.0, "../src/soundfiles/pig.wav", "../src/imagefiles/pig.png",  1, 1, 0.1) { material_ = Material::Pig; }
     ~NormalPig () {}
 };
 
 class KingPig : public Pig {
 public:
-    KingPig (double x, double y) : Pig (45, x, y, 50.0, 50.0, "../src/soundfiles/pig.wav", "../src/imagefiles/kingpig.png", 1, 1, 0.1) {}
+    KingPig (double x, double y) : Pig (45, x, y, 50.0, 50.0, "../src/soundfiles/pig.wav", "../src/imagefiles/kingpig.png", 1, 1, 0.1) { material_ = Material::King; }
     ~KingPig () {}
 };
\ No newline at end of file
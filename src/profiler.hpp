@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "tracer.hpp"
+
+/**
+ * @brief Timed parts of a frame. Physics and Sync run inside Update.
+ */
+enum class ProfileSection { Events, Update, Physics, Sync, Render, Display, Count };
+
+/**
+ * @brief Numbers counted for each frame.
+ */
+enum class ProfileCounter { Bodies, Contacts, DrawCalls, SoundsStarted, Count };
+
+/**
+ * @class Profiler
+ * @brief Collects the time spent in each section of a frame and a few counters.
+ *
+ * Game::run() brackets every frame with PROFILE_FRAME_BEGIN and PROFILE_FRAME_END. The sections
+ * are timed by PROFILE_SCOPE and the counters set by PROFILE_COUNT and PROFILE_GAUGE, all of
+ * which read the profiler returned by get(). The last kHistory frames are kept for
+ * percentiles, and every frame can be written as a row of a CSV file. PROFILE_SCOPE also
+ * records its section as a zone of the Tracer.
+ *
+ * Nothing is timed or counted while the profiler is disabled, which it is until the overlay
+ * is shown or a CSV file is opened. Enabling or disabling takes effect at the next
+ * beginFrame(), so a frame is measured either whole or not at all. Without ANGRY_BIRDS_PROFILER defined the macros are
+ * empty, so the instrumented code does not even check.
+ */
+class Profiler {
+public:
+    static constexpr std::size_t kHistory = 240;    // frames the percentiles are taken over, 4 seconds at 60 fps
+    static constexpr std::size_t kSections = static_cast<std::size_t>(ProfileSection::Count);
+    static constexpr std::size_t kCounters = static_cast<std::size_t>(ProfileCounter::Count);
+
+    /**
+     * @brief The times and counters of one frame.
+     */
+    struct Frame {
+        double total = 0;                           // milliseconds from beginFrame() to endFrame()
+        std::array<double, kSections> sections{};   // milliseconds in each section
+        std::array<long, kCounters> counters{};
+    };
+
+    /**
+     * @brief Get the profiler of the game, used by the macros.
+     */
+    static Profiler& get() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    /**
+     * @brief Check if frames are being measured.
+     */
+    bool isEnabled() const { return enabled_; }
+
+    /**
+     * @brief Measure frames for the overlay, whether or not a CSV file is open.
+     */
+    void setShown(bool shown) {
+        shown_ = shown;
+        enabled_ = shown_ || csv_.is_open();
+    }
+
+    bool isShown() const { return shown_; }
+
+    /**
+     * @brief Write every following frame as a row of a CSV file, with a header row first.
+     *
+     * @param path The file to write, replaced if it exists.
+     */
+    void openCsv(const std::string& path) {
+        csv_.open(path);
+        if (!csv_) {
+            throw std::runtime_error("Failed opening the file " + path + " for writing!");
+        }
+        csv_ << "frame,frame_ms";
+        for (std::size_t i = 0; i < kSections; i++) { csv_ << "," << sectionName(i) << "_ms"; }
+        for (std::size_t i = 0; i < kCounters; i++) { csv_ << "," << counterName(i); }
+        csv_ << "\n";
+        enabled_ = true;
+    }
+
+    /**
+     * @brief Start measuring a frame.
+     */
+    void beginFrame() {
+        frameOpen_ = enabled_;
+        if (!frameOpen_) { return; }
+        current_ = Frame();
+        frameStart_ = Clock::now();
+    }
+
+    /**
+     * @brief Finish the frame started by beginFrame(), keep it and write its CSV row.
+     */
+    void endFrame() {
+        if (!frameOpen_) { return; }
+        frameOpen_ = false;
+        current_.total = milliseconds(frameStart_, Clock::now());
+        if (history_.size() < kHistory) {
+            history_.push_back(current_);
+        }
+        else {
+            history_[next_] = current_;
+        }
+        next_ = (next_ + 1) % kHistory;
+        if (csv_.is_open()) {
+            csv_ << frames_ << "," << current_.total;
+            for (double time : current_.sections) { csv_ << "," << time; }
+            for (long count : current_.counters) { csv_ << "," << count; }
+            csv_ << "\n";
+        }
+        frames_++;
+    }
+
+    /**
+     * @brief Add time to a section of the current frame, called by ScopedTimer.
+     */
+    void addTime(ProfileSection section, double ms) {
+        if (frameOpen_) { current_.sections[static_cast<std::size_t>(section)] += ms; }
+    }
+
+    /**
+     * @brief Add to a counter of the current frame, e.g. one per draw call.
+     */
+    void count(ProfileCounter counter, long amount) {
+        if (frameOpen_) { current_.counters[static_cast<std::size_t>(counter)] += amount; }
+    }
+
+    /**
+     * @brief Set a counter of the current frame, e.g. to the number of bodies.
+     */
+    void gauge(ProfileCounter counter, long value) {
+        if (frameOpen_) { current_.counters[static_cast<std::size_t>(counter)] = value; }
+    }
+
+    /**
+     * @brief Get a percentile of a section over the kept frames.
+     *
+     * @param section The section, or ProfileSection::Count for the whole frame.
+     * @param percent 0 to 100, e.g. 50 for the median.
+     * @return Milliseconds, 0 if no frame has been measured.
+     */
+    double percentile(ProfileSection section, double percent) const {
+        if (history_.empty()) { return 0; }
+        std::vector<double> times;
+        times.reserve(history_.size());
+        for (const Frame& frame : history_) {
+            times.push_back(section == ProfileSection::Count ? frame.total : frame.sections[static_cast<std::size_t>(section)]);
+        }
+        std::size_t rank = static_cast<std::size_t>(percent / 100 * (times.size() - 1) + 0.5);
+        std::nth_element(times.begin(), times.begin() + rank, times.end());
+        return times[rank];
+    }
+
+    /**
+     * @brief Get the last finished frame.
+     */
+    const Frame& getLastFrame() const {
+        static const Frame none;
+        return history_.empty() ? none : history_[(next_ + kHistory - 1) % kHistory];
+    }
+
+    /**
+     * @brief Get the number of frames measured.
+     */
+    long getFrames() const { return frames_; }
+
+    static const char* sectionName(std::size_t section) {
+        static const char* names[kSections] = { "events", "update", "physics", "sync", "render", "display" };
+        return names[section];
+    }
+
+    static const char* counterName(std::size_t counter) {
+        static const char* names[kCounters] = { "bodies", "contacts", "draw_calls", "sounds" };
+        return names[counter];
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static double milliseconds(Clock::time_point from, Clock::time_point to) {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+
+    friend class ScopedTimer;
+
+    bool enabled_ = false;
+    bool shown_ = false;
+    bool frameOpen_ = false;        // the current frame began while enabled, so endFrame() keeps it
+    Frame current_;
+    Clock::time_point frameStart_;
+    std::vector<Frame> history_;    // ring of the last kHistory frames
+    std::size_t next_ = 0;          // place of the next frame in history_
+    long frames_ = 0;
+    std::ofstream csv_;
+};
+
+/**
+ * @class ScopedTimer
+ * @brief Adds the time until it goes out of scope to a section of the current frame.
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(ProfileSection section, Profiler& profiler = Profiler::get())
+        : profiler_(profiler.isEnabled() ? &profiler : nullptr), section_(section) {
+        if (profiler_) { start_ = Profiler::Clock::now(); }
+    }
+
+    ~ScopedTimer() {
+        if (profiler_) { profiler_->addTime(section_, Profiler::milliseconds(start_, Profiler::Clock::now())); }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Profiler* profiler_;        // nullptr if the profiler was disabled
+    ProfileSection section_;
+    Profiler::Clock::time_point start_;
+};
+
+#ifdef ANGRY_BIRDS_PROFILER
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_FRAME_BEGIN() Profiler::get().beginFrame()
+#define PROFILE_FRAME_END() Profiler::get().endFrame()
+#define PROFILE_SCOPE(section) ScopedTimer PROFILE_CONCAT(profileTimer_, __LINE__)(section); \
+    TraceZone PROFILE_CONCAT(profileZone_, __LINE__)(Profiler::sectionName(static_cast<std::size_t>(section)))
+#define PROFILE_COUNT(counter, amount) Profiler::get().count(counter, amount)
+#define PROFILE_GAUGE(counter, value) Profiler::get().gauge(counter, value)
+#else
+#define PROFILE_FRAME_BEGIN() ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#define PROFILE_SCOPE(section) ((void)0)
+#define PROFILE_COUNT(counter, amount) ((void)0)
+#define PROFILE_GAUGE(counter, value) ((void)0)
+#endif
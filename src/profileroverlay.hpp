@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <SFML/Graphics.hpp>
+#include "profiler.hpp"
+
+/**
+ * @class ProfilerOverlay
+ * @brief Draws the percentiles and counters of a Profiler in the top left corner of the window.
+ *
+ * The text is laid out again only a few times a second, so the overlay does not show up much
+ * in the numbers it shows.
+ */
+class ProfilerOverlay {
+public:
+    ProfilerOverlay() {
+        if (!font_.loadFromFile("../src/fontfiles/Lato-Regular.ttf")) {
+            throw std::runtime_error("Could not load font from file");
+        }
+        text_.setFont(font_);
+        text_.setCharacterSize(14);
+        text_.setFillColor(sf::Color::White);
+        text_.setPosition(10, 10);
+        background_.setFillColor(sf::Color(0, 0, 0, 160));
+    }
+
+    /**
+     * @brief Draw the overlay over whatever view the window has.
+     */
+    void draw(sf::RenderWindow& window, const Profiler& profiler) {
+        if (profiler.getFrames() - shownFrame_ >= kRefreshFrames || profiler.getFrames() < shownFrame_) {
+            shownFrame_ = profiler.getFrames();
+            layout(profiler);
+        }
+        sf::View view = window.getView();
+        window.setView(window.getDefaultView());
+        window.draw(background_);
+        window.draw(text_);
+        window.setView(view);
+    }
+
+private:
+    static constexpr long kRefreshFrames = 15;      // frames between layouts of the text
+
+    void layout(const Profiler& profiler) {
+        std::string string = "ms           p50     p95     p99\n";
+        char line[64];
+        auto addLine = [&](const char* name, ProfileSection section) {
+            std::snprintf(line, sizeof(line), "%-10s %6.2f  %6.2f  %6.2f\n", name, profiler.percentile(section, 50),
+                          profiler.percentile(section, 95), profiler.percentile(section, 99));
+            string += line;
+        };
+        addLine("frame", ProfileSection::Count);
+        for (std::size_t i = 0; i < Profiler::kSections; i++) {
+            addLine(Profiler::sectionName(i), static_cast<ProfileSection>(i));
+        }
+        const Profiler::Frame& frame = profiler.getLastFrame();
+        for (std::size_t i = 0; i < Profiler::kCounters; i++) {
+            string += std::string(Profiler::counterName(i)) + " " + std::to_string(frame.counters[i]) + "\n";
+        }
+        text_.setString(string);
+        sf::FloatRect bounds = text_.getGlobalBounds();
+        background_.setPosition(bounds.left - 5, bounds.top - 5);
+        background_.setSize(sf::Vector2f(bounds.width + 10, bounds.height + 10));
+    }
+
+    sf::Font font_;
+    sf::Text text_;
+    sf::RectangleShape background_;
+    long shownFrame_ = -kRefreshFrames;     // frame the text was laid out at
+};
@@ -8,11 +8,17 @@
 #include "slingshot.hpp"
 #include "inputbox.hpp"
 #include "star.hpp"
+#include "assetcache.hpp"
+#include "worldbatch.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
 
 
 class Render {
     public:
-        Render() {
+        Render() : world_(AssetCache::getAtlas()) {
             if (!starTexture_.loadFromFile("../src/imagefiles/star.png")) {
                 throw std::runtime_error("Loading star failed!");
             }
@@ -34,6 +40,13 @@ class Render {
             if (!menuBackgroundTexture_.loadFromFile("../src/imagefiles/menu_background.png")) {
                 throw std::runtime_error("Loading background failed!");
             }
+            levelBackground_.setTexture(levelBackgroundTexture_);
+            menuBackground_.setTexture(menuBackgroundTexture_);
+            for (sf::Text* text : { &pigsText_, &birdsText_, &scoreText_ }) {
+                text->setFillColor(sf::Color::Magenta);
+                text->setCharacterSize(30);
+                text->setFont(latoRegular_);
+            }
         }
         /**
          * @brief Draw Button object button.
@@ -45,52 +58,134 @@ class Render {
         }
 
         /**
-         * @brief Draw Pig object pig.
+         * @brief Start batching the world layer of a frame, culled against the current view of the target.
          * 
-         * @param pig The Pig object to be drawn.
+         * @param target The window the layer will be drawn to.
          */
-        void renderPig(sf::RenderWindow& window, Pig& pig) {
-            if (pig.getHp() > 0)
-            {
-                window.draw(pig.getSprite());
+        void beginWorld(const sf::RenderTarget& target) {
+            const sf::View& view = target.getView();
+            sf::Vector2f size = view.getSize();
+            if (view.getRotation() != 0) {
+                // a rotated view is culled by the square around it
+                float side = std::hypot(size.x, size.y);
+                size = sf::Vector2f(side, side);
             }
+            world_.setCullRect(sf::FloatRect(view.getCenter() - size / 2.0f, size));
         }
 
         /**
-         * @brief Draw Bird object bird.
+         * @brief Add a bird, pig, obstacle or star to the batched world layer.
          * 
-         * @param bird The Bird object to be drawn.
+         * Destroyed objects are skipped. The layer is drawn with renderWorld().
+         * 
+         * @param object The object to be drawn.
          */
-        void renderBird(sf::RenderWindow& window, Bird& bird) {
-            if (bird.getHp() > 0)
+        void batchObject(Object& object) {
+            if (object.getHp() > 0)
             {
-                window.draw(bird.getSprite());
+                world_.add(object);
+            }
+        }
+
+        /**
+         * @brief Add every object of a TransformBuffer to the batched world layer, in slot order.
+         * 
+         * The positions, rotations and bounds are read from the arrays of the buffer, so objects
+         * outside the view are culled without being touched. Destroyed objects are skipped.
+         * 
+         * @param transforms The drawn transforms of a level.
+         */
+        void batchTransforms(const TransformBuffer& transforms) {
+            const float* x = transforms.getX();
+            const float* y = transforms.getY();
+            const float* angle = transforms.getAngle();
+            const float* radius = transforms.getRadius();
+            for (std::size_t i = 0; i < transforms.size(); i++) {
+                sf::Vector2f center(x[i], y[i]);
+                if (!world_.visible(center, radius[i])) {
+                    continue;
+                }
+                const Object& object = *transforms.getObject(i);
+                if (object.getHp() > 0)
+                {
+                    world_.add(object, center, angle[i]);
+                }
             }
         }
 
+        /**
+         * @brief Draw every object batched since the last call with one draw call.
+         */
+        void renderWorld(sf::RenderWindow& window) {
+            world_.draw(window);
+            drawn_ = world_.size();
+            culled_ = world_.getCulled();
+            world_.clear();
+        }
+
+        /**
+         * @brief Get the number of objects the last renderWorld() drew.
+         */
+        std::size_t getDrawn() const { return drawn_; }
+
+        /**
+         * @brief Get the number of objects outside the view skipped by the last renderWorld().
+         */
+        std::size_t getCulled() const { return culled_; }
+
         /**
          * @brief Draw Obstacle object obstacle.
          * 
          * @param obstacle The Obstacle object to be drawn.
          */
-        void renderObstacle(sf::RenderWindow& window, Obstacle& obstacle) {
+        void renderObstacle(sf::RenderTarget& window, Obstacle& obstacle) {
             if (obstacle.getHp() > 0)
             {
-                window.draw(obstacle.getSprite());
+                // objects do not hold graphics, the sprite of each texture is kept here
+                sf::Sprite& sprite = sprites_[obstacle.getTextureFilePath()];
+                if (!sprite.getTexture()) {
+                    textures_.push_back(AssetCache::getTexture(obstacle.getTextureFilePath()));
+                    sprite.setTexture(*textures_.back());
+                    sf::FloatRect bounds = sprite.getLocalBounds();
+                    sprite.setOrigin(bounds.width / 2, bounds.height / 2);
+                }
+                sf::Vector2u size = sprite.getTexture()->getSize();
+                sprite.setScale(obstacle.getWidth() / size.x, obstacle.getHeight() / size.y);
+                sprite.setPosition(obstacle.getX(), obstacle.getY());
+                sprite.setRotation(obstacle.getAngle());
+                draw(window, sprite);
             }
         }
 
-        void renderSlingShot(sf::RenderWindow& window, Slingshot& slingshot) {
-            window.draw(slingshot.getSprite());
+        /**
+         * @brief Draw the predicted flight path of the bird as dots.
+         * 
+         * @param points The dots of the path in pixels.
+         * @param impact Where the bird hits first, nullptr if it is not known.
+         */
+        void renderTrajectory(sf::RenderWindow& window, const std::vector<sf::Vector2f>& points, const sf::Vector2f* impact) {
+            sf::CircleShape dot(3);
+            dot.setOrigin(3, 3);
+            dot.setFillColor(sf::Color(255, 255, 255, 200));
+            for (const auto& point : points) {
+                dot.setPosition(point);
+                draw(window, dot);
+            }
+            if (impact) {
+                sf::CircleShape mark(8);
+                mark.setOrigin(8, 8);
+                mark.setFillColor(sf::Color::Transparent);
+                mark.setOutlineColor(sf::Color::Red);
+                mark.setOutlineThickness(2);
+                mark.setPosition(*impact);
+                draw(window, mark);
+            }
         }
 
-        void renderStar(sf::RenderWindow& window, Star& star) {
-            if (star.getHp() > 0)
-            {
-                window.draw(star.getSprite());
-            }
+        void renderSlingShot(sf::RenderTarget& window, Slingshot& slingshot) {
+            draw(window, slingshot.getSprite());
         }
-        
+
         void renderHeading(sf::RenderWindow& window, const std::string& string, float y) {
             sf::Text text;
             text.setFillColor(sf::Color::Magenta);
@@ -98,7 +193,7 @@ class Render {
             text.setFont(latoBlack_);
             text.setString(string);
             text.setPosition(window.getSize().x / 2 - text.getGlobalBounds().width / 2, y);
-            window.draw(text);
+            draw(window, text);
         }
 
         void renderHighScores(sf::RenderWindow& window, Scores highscores) {
@@ -110,7 +205,7 @@ class Render {
             int pos_y = 250;
             text.setString("Top 5:");
             text.setPosition(width - text.getGlobalBounds().width / 2, pos_y);
-            window.draw(text);
+            draw(window, text);
             text.setFont(latoRegular_);
             pos_y = pos_y + 50;
             for (auto pair : highscores) {
@@ -118,42 +213,57 @@ class Render {
                     text.setString(pair.second + ": " + std::to_string(pair.first));
                     text.setPosition(width - text.getGlobalBounds().width / 2, pos_y);
                     pos_y = pos_y + 45;
-                    window.draw(text);
+                    draw(window, text);
                 }
             }
         }
 
-        void renderBackground(sf::RenderWindow& window, bool isLevelBackground) {
-            float texture_x = static_cast<float>(levelBackgroundTexture_.getSize().x);
-            float texture_y = static_cast<float>(levelBackgroundTexture_.getSize().y); 
-            sf::Sprite sprite;
-            if (isLevelBackground){ 
-                sprite.setTexture(levelBackgroundTexture_);
-            }
-            else { 
-                sprite.setTexture(menuBackgroundTexture_);
-                texture_x = static_cast<float>(menuBackgroundTexture_.getSize().x);
-                texture_y = static_cast<float>(menuBackgroundTexture_.getSize().y); 
-            }
-            
-            // Calculate the scale factors
-            float window_x = static_cast<float>(window.getSize().x);
-            float window_y = static_cast<float>(window.getSize().y);
-
-            float x_scale = 1.01 * window_x / texture_x;
-            float y_scale = window_y / texture_y;
+        void renderBackground(sf::RenderTarget& target, bool isLevelBackground) {
+            sf::Sprite& sprite = isLevelBackground ? levelBackground_ : menuBackground_;
+            sf::Vector2u texture = sprite.getTexture()->getSize();
+            sf::Vector2f size(target.getSize());
 
             // Set the sprite scale to stretch the background
-            sprite.setScale(x_scale, y_scale);
-            window.draw(sprite);
+            sprite.setScale(1.01f * size.x / texture.x, size.y / texture.y);
+            draw(target, sprite);
+        }
+
+        /**
+         * @brief Draw the background, the ground and the slingshot of a level.
+         * 
+         * They never move, so they are drawn once into a texture that is then drawn with one
+         * sprite every frame. The texture has twice the resolution of the window so that it
+         * stays sharp when zoomed in. A ground wider than the window is drawn every frame
+         * instead, with the slingshot over it, and the texture only holds the background.
+         * If the texture cannot be created everything is drawn every frame.
+         * 
+         * @param window The SFML render window.
+         * @param ground The ground of the level.
+         * @param slingshot The slingshot of the level.
+         */
+        void renderScenery(sf::RenderWindow& window, Obstacle& ground, Slingshot& slingshot) {
+            if (sceneryState_ == SceneryState::Empty) {
+                buildScenery(window, ground, slingshot);
+            }
+            if (sceneryState_ == SceneryState::Failed) {
+                renderBackground(window, true);
+                renderObstacle(window, ground);
+                renderSlingShot(window, slingshot);
+                return;
+            }
+            draw(window, scenery_);
+            if (sceneryState_ == SceneryState::Background) {
+                renderObstacle(window, ground);
+                renderSlingShot(window, slingshot);
+            }
         }
 
         void renderInputBox(sf::RenderWindow& window, InputBox& box) {
-            window.draw(box.getOutline());
+            draw(window, box.getOutline());
             if (box.hasText()) {
-                window.draw(box.getText());
+                draw(window, box.getText());
             }
-            else { window.draw(box.getPrompt()); }
+            else { draw(window, box.getPrompt()); }
         }
 
         void renderStars(sf::RenderWindow& window, int stars) {
@@ -168,7 +278,7 @@ class Render {
             sprite.setScale(size / starTexture_.getSize().x, size / starTexture_.getSize().y);
             for (int i = 0; i < stars; ++i) {
                 sprite.setPosition(x, y);
-                window.draw(sprite);
+                draw(window, sprite);
                 x += size + space;
             }
             // draw outlines
@@ -176,46 +286,78 @@ class Render {
             sprite.setTexture(starOutlineTexture_);
             for (int i = 0; i < (3 - stars); ++i) {
                 sprite.setPosition(x, y);
-                window.draw(sprite);
+                draw(window, sprite);
                 x += size + space;
             }
         }
 
+        /**
+         * @brief Draw the pigs left, birds left and score in the top right corner.
+         * 
+         * The texts are kept between frames and only laid out again when a number changes.
+         */
         void renderLevelInfo(sf::RenderWindow& window, int pigs, int birds, int score) {
-            // text object to draw texts
-            sf::Text text;
-            text.setFillColor(sf::Color::Magenta);
-            text.setCharacterSize(30);
-            text.setFont(latoRegular_);
-            // pigs left text
-            text.setString("Pigs left: " + std::to_string(pigs));
-            float width = text.getGlobalBounds().width;
-            float height = text.getGlobalBounds().height;
-            float space = 10;
-            float pos_x = window.getSize().x - width - 2 * space;
-            float pos_y = space + height;
-            text.setPosition(pos_x, pos_y);
-            pos_y += space + height;
-            window.draw(text);
-            // birds left text
-            text.setString("Birds left: " + std::to_string(birds));
-            width = text.getGlobalBounds().width;
-            height = text.getGlobalBounds().height;
-            pos_x = window.getSize().x - width - 2 * space;
-            text.setPosition(pos_x, pos_y);
-            pos_y += space + height;
-            window.draw(text);
-            // score text
-            // birds left text
-            text.setString("Score: " + std::to_string(score));
-            width = text.getGlobalBounds().width;
-            height = text.getGlobalBounds().height;
-            pos_x = window.getSize().x - width - 2 * space;
-            text.setPosition(pos_x, pos_y);
-            window.draw(text);
+            float right = static_cast<float>(window.getSize().x);
+            if (pigs != shownPigs_ || birds != shownBirds_ || score != shownScore_ || right != shownRight_) {
+                shownPigs_ = pigs;
+                shownBirds_ = birds;
+                shownScore_ = score;
+                shownRight_ = right;
+                pigsText_.setString("Pigs left: " + std::to_string(pigs));
+                birdsText_.setString("Birds left: " + std::to_string(birds));
+                scoreText_.setString("Score: " + std::to_string(score));
+                // right aligned, each line below the previous one
+                float space = 10;
+                float pos_y = space + pigsText_.getLocalBounds().height;
+                for (sf::Text* text : { &pigsText_, &birdsText_, &scoreText_ }) {
+                    sf::FloatRect bounds = text->getLocalBounds();
+                    text->setPosition(right - bounds.width - 2 * space, pos_y);
+                    pos_y += space + bounds.height;
+                }
+            }
+            draw(window, pigsText_);
+            draw(window, birdsText_);
+            draw(window, scoreText_);
         }
 
     private:
+        /**
+         * @brief Draw to a window or texture, counted as a draw call by the profiler.
+         */
+        static void draw(sf::RenderTarget& target, const sf::Drawable& drawable) {
+            target.draw(drawable);
+            PROFILE_COUNT(ProfileCounter::DrawCalls, 1);
+        }
+
+        /**
+         * @brief Draw the scenery into sceneryTexture_, see renderScenery().
+         */
+        void buildScenery(sf::RenderWindow& window, Obstacle& ground, Slingshot& slingshot) {
+            sf::Vector2f size(window.getSize());
+            float groundRight = ground.getX() + ground.getWidth() / 2;
+            bool withGround = groundRight <= 1.05f * size.x;   // the usual ground reaches a bit past the window
+            float width = withGround ? std::max(1.01f * size.x, groundRight) : 1.01f * size.x;
+            if (!sceneryTexture_.create(static_cast<unsigned>(std::ceil(width)) * kSceneryScale,
+                                        static_cast<unsigned>(size.y) * kSceneryScale)) {
+                sceneryState_ = SceneryState::Failed;
+                return;
+            }
+            sceneryTexture_.setView(sf::View(sf::FloatRect(0, 0, std::ceil(width), size.y)));
+            sceneryTexture_.clear(sf::Color::Transparent);
+            float backgroundScale = 1.01f * size.x / levelBackgroundTexture_.getSize().x;
+            levelBackground_.setScale(backgroundScale, size.y / levelBackgroundTexture_.getSize().y);
+            draw(sceneryTexture_, levelBackground_);
+            if (withGround) {
+                renderObstacle(sceneryTexture_, ground);
+                renderSlingShot(sceneryTexture_, slingshot);
+            }
+            sceneryTexture_.display();
+            sceneryTexture_.setSmooth(true);
+            scenery_.setTexture(sceneryTexture_.getTexture(), true);
+            scenery_.setScale(1.0f / kSceneryScale, 1.0f / kSceneryScale);
+            sceneryState_ = withGround ? SceneryState::Full : SceneryState::Background;
+        }
+
         sf::Texture starTexture_;
         sf::Texture starOutlineTexture_;
         sf::Font latoRegular_;
@@ -223,5 +365,24 @@ class Render {
         sf::Font latoBlack_;
         sf::Texture levelBackgroundTexture_;
         sf::Texture menuBackgroundTexture_;
+        sf::Sprite levelBackground_;
+        sf::Sprite menuBackground_;
+        enum class SceneryState { Empty, Full, Background, Failed };
+        SceneryState sceneryState_ = SceneryState::Empty;   // what scenery_ holds, built by the first renderScenery()
+        sf::RenderTexture sceneryTexture_;
+        sf::Sprite scenery_;
+        static constexpr unsigned kSceneryScale = 2;        // resolution of the scenery texture per window pixel
+        sf::Text pigsText_;
+        sf::Text birdsText_;
+        sf::Text scoreText_;
+        int shownPigs_ = -1;            // numbers the texts show, -1 before the first frame
+        int shownBirds_ = -1;
+        int shownScore_ = -1;
+        float shownRight_ = 0;          // window width the texts are aligned to
+        WorldBatch world_;
+        std::size_t drawn_ = 0;     // objects of the world layer drawn in the last frame
+        std::size_t culled_ = 0;    // and skipped because they were outside the view
+        std::vector<std::shared_ptr<sf::Texture>> textures_;   // textures of objects drawn with their own sprite
+        std::map<std::string, sf::Sprite> sprites_;             // sprite for each texture path
 };
 
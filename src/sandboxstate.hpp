@@ -3,7 +3,13 @@
 #include "gamestate.hpp"
 #include "highscores.hpp"
 #include "collisiondetection.hpp"
+#include "assetcache.hpp"
+#include "fixedstepscheduler.hpp"
+#include "awakeset.hpp"
+#include "objectpicker.hpp"
+#include "profiler.hpp"
 #include <cmath>
+#include <filesystem>
 #include <memory>
 
     class SandboxState : public GameState {
@@ -13,13 +19,12 @@
          * set the gravity and the physics world with that gravity, highscores objects, level number, whether the level is saved and zoom
          */
         SandboxState() : gravity_(0.0f, 9.8f), world_(gravity_), highscores_(HighScores()), level_number_(4), saved_(false), currentZoom_(0) {
-            if (!soundBuffer_.loadFromFile("../src/soundfiles/binsound.wav")) {
-                // throw error
-                throw std::runtime_error("Error loading sound file: binsound.wav !");
-            }
-            sound_.setBuffer(soundBuffer_);
+            soundBuffer_ = AssetCache::getSoundBuffer("../src/soundfiles/binsound.wav");
+            sound_.setBuffer(*soundBuffer_);
             sound_.setVolume(50);
             LevelData data(level_number_);
+            pool_ = data.getPool();
+            worldbounds_.width = data.getWidth();
             initButtons();
             initMusic();
             for (auto& bird : data.getBirds()) 
@@ -51,6 +56,12 @@
                 star_->setBodyStatic();
                 star_->getBody()->GetFixtureList()->SetSensor(true);
             }
+            // everything is synced once, then only what moves
+            world_.SetContactListener(&awakeListener_);
+            for (auto& bird : birds_) { addObject(bird.get()); }
+            for (auto& pig : pigs_) { addObject(pig.get()); }
+            for (auto& obstacle : obstacles_) { addObject(obstacle.get()); }
+            if (star_) { addObject(star_.get()); }
         }
 
         ~SandboxState() {
@@ -158,35 +169,15 @@
                     }
                 }
                 if (!object_in_turn_) {
-                    for (auto& bird : birds_) {
-                        if (bird->inBounds(position, window)) {
-                            dragging_ = true;
-                            object_in_turn_ = bird;
-                            object_in_turn_->getBody()->SetAwake(false);
+                    // topmost object under the mouse, found through the broad-phase of the world
+                    object_in_turn_ = picker_.pick(world_, globalPosition);
+                    if (object_in_turn_) {
+                        dragging_ = true;
+                        object_in_turn_->getBody()->SetAwake(false);
+                        if (dynamic_cast<Bird*>(object_in_turn_)) {
                             posOfBird_ = object_in_turn_->getBody()->GetPosition();
                         }
                     }
-                    for (auto& pig : pigs_) {
-                        if (pig->inBounds(position, window)) {
-                            dragging_ = true;
-                            object_in_turn_ = pig;
-                            object_in_turn_->getBody()->SetAwake(false);
-                        }
-                    }
-                    for (auto& obstacle : obstacles_) {
-                        if (obstacle->inBounds(position, window)) {
-                            dragging_ = true;
-                            object_in_turn_ = obstacle;
-                            object_in_turn_->getBody()->SetAwake(false);
-                        }
-                    }
-                    if (star_) {
-                        if (star_->inBounds(position, window)) {
-                            dragging_ = true;
-                            object_in_turn_ = star_;
-                            object_in_turn_->getBody()->SetAwake(false);
-                        }
-                    }
                 }   
             }
         }
@@ -196,7 +187,8 @@
             sf::Vector2f globalPosition = window.mapPixelToCoords(position);
             if (object_in_turn_ && dragging_) {
                 b2Vec2 newPos(globalPosition.x/100.0f, globalPosition.y/100.0f);
-                object_in_turn_->getBody()->SetTransform(newPos, 0);
+                object_in_turn_->setTransform(newPos, 0);
+                awake_.add(object_in_turn_);
                 if (bin_button_->inBounds(position, window)) {
                     bin_button_->changeToDarkRed();
                 }
@@ -236,11 +228,12 @@
                     removeObject();
                 }
                 else {
-                    if (!dynamic_cast<Star*>(object_in_turn_.get())) {
-                        if (dynamic_cast<Bird*>(object_in_turn_.get())) {
-                            object_in_turn_->getBody()->SetTransform(posOfBird_, 0);
+                    if (!dynamic_cast<Star*>(object_in_turn_)) {
+                        if (dynamic_cast<Bird*>(object_in_turn_)) {
+                            object_in_turn_->setTransform(posOfBird_, 0);
                         }
                         object_in_turn_->getBody()->SetAwake(true);
+                        awake_.add(object_in_turn_);
                     }
                 }
                 dragging_ = false;
@@ -250,51 +243,67 @@
             return "";
         }
 
+        /**
+         * @brief Put an object on top of the others of its kind and sync its drawn transform
+         */
+        void addObject(Object* object) {
+            object->setDrawOrder(nextDrawOrder_++);
+            awake_.add(object);
+        }
+
         /**
          * @brief Create objects into the game
          *  
          */
         void createObject(std::string name) {
             if (name == "red") {
-                std::shared_ptr<RedBird> bird = std::make_shared<RedBird>(40*birdcount_+130, 585);
+                std::shared_ptr<RedBird> bird = ObjectPool::make<RedBird>(pool_, 40*birdcount_+130, 585);
                 bird->initializePhysicsWorld(world_);
+                addObject(bird.get());
                 birds_.push_back(bird);
                 birdcount_++;
             }
             else if (name == "yellow") {
-                std::shared_ptr<YellowBird> bird = std::make_shared<YellowBird>(40*birdcount_+130, 590);
+                std::shared_ptr<YellowBird> bird = ObjectPool::make<YellowBird>(pool_, 40*birdcount_+130, 590);
                 bird->initializePhysicsWorld(world_);
+                addObject(bird.get());
                 birds_.push_back(bird);
                 birdcount_++;
             }
             else if (name == "pig") {
-                std::shared_ptr<NormalPig> pig = std::make_shared<NormalPig>(683, 0);
+                std::shared_ptr<NormalPig> pig = ObjectPool::make<NormalPig>(pool_, 683, 0);
                 pig->initializePhysicsWorld(world_);
+                addObject(pig.get());
                 pigs_.push_back(pig);
             }
             else if (name == "king") {
-                std::shared_ptr<KingPig> pig = std::make_shared<KingPig>(683, 0);
+                std::shared_ptr<KingPig> pig = ObjectPool::make<KingPig>(pool_, 683, 0);
                 pig->initializePhysicsWorld(world_);
+                addObject(pig.get());
                 pigs_.push_back(pig);
             }
             else if (name == "wood") {
-                std::shared_ptr<WoodObstacle> obstacle = std::make_shared<WoodObstacle>(683, 0);
+                std::shared_ptr<WoodObstacle> obstacle = ObjectPool::make<WoodObstacle>(pool_, 683, 0);
                 obstacle->initializePhysicsWorld(world_);
+                addObject(obstacle.get());
                 obstacles_.push_back(obstacle);
             }
             else if (name == "stone") {
-                std::shared_ptr<StoneObstacle> obstacle = std::make_shared<StoneObstacle>(683, 0);
+                std::shared_ptr<StoneObstacle> obstacle = ObjectPool::make<StoneObstacle>(pool_, 683, 0);
                 obstacle->initializePhysicsWorld(world_);
+                addObject(obstacle.get());
                 obstacles_.push_back(obstacle);
             }
             else if (name == "glass") {
-                std::shared_ptr<GlassObstacle> obstacle = std::make_shared<GlassObstacle>(683, 0);
+                std::shared_ptr<GlassObstacle> obstacle = ObjectPool::make<GlassObstacle>(pool_, 683, 0);
                 obstacle->initializePhysicsWorld(world_);
+                addObject(obstacle.get());
                 obstacles_.push_back(obstacle);
             }
             else if (name == "star" && !star_) {
-                star_ = std::make_shared<Star>(683, 384);
+                star_ = ObjectPool::make<Star>(pool_, 683, 384);
                 star_->initializePhysicsWorld(world_);
+                addObject(star_.get());
                 star_->getBody()->SetAwake(false);
             }
         }
@@ -305,7 +314,8 @@
          */
         void saveToFile() {
             highscores_.clearSandBoxScores();
-            std::ofstream sandboxfile("../src/textfiles/sandboxlevel.txt");
+            std::string filepath = LevelData::getLevelPath(level_number_);
+            std::ofstream sandboxfile(filepath);
             if (sandboxfile.is_open()) {
                 // std::cout << "Sandbox file opened and cleared successfully" << std::endl;
                 sandboxfile << "Birds\n";
@@ -345,6 +355,9 @@
                 // std::cout << "File written successfully" << std::endl;
             }
             else { std::cerr << "Failed to open the file.\n"; }
+            // drop the compiled copy of the old level so it is not loaded instead of the new one
+            std::error_code error;
+            std::filesystem::remove(LevelFile::compiledPath(filepath), error);
             saved_ = true;
             saveClock_.restart();
         }
@@ -355,28 +368,36 @@
          */
         void removeObject() {
             playBinSound();
-            pigs_.erase(std::remove(pigs_.begin(), pigs_.end(), object_in_turn_), pigs_.end());
-            obstacles_.erase(std::remove(obstacles_.begin(), obstacles_.end(), object_in_turn_), obstacles_.end());
-            bodiesToRemove_.push_back(object_in_turn_->getBody());
-            if (dynamic_cast<Star*>(object_in_turn_.get())) {
+            // the vectors own the object, so everything needed from it is read before it is erased
+            Object* object = object_in_turn_;
+            bool isBird = dynamic_cast<Bird*>(object) != nullptr;
+            auto isObject = [object](const auto& other) { return other.get() == object; };
+            awake_.remove(object);
+            // out of contacts and picking until the body is destroyed after the next step
+            object->getBody()->SetEnabled(false);
+            bodiesToRemove_.push_back(object->getBody());
+            pigs_.erase(std::remove_if(pigs_.begin(), pigs_.end(), isObject), pigs_.end());
+            obstacles_.erase(std::remove_if(obstacles_.begin(), obstacles_.end(), isObject), obstacles_.end());
+            if (star_.get() == object) {
                 star_ = nullptr;
             }
-            if (dynamic_cast<Bird*>(object_in_turn_.get())) {
+            if (isBird) {
                 // std::cout << "Before remove: ";
                 for (const auto& bird : birds_) {
                     // std::cout << bird << " . "; 
                 }
                 // std::cout << std::endl;
                 // std::cout << "removing bird" << std::endl;
-                auto it1 = std::find(birds_.begin(), birds_.end(), object_in_turn_);
+                auto it1 = std::find_if(birds_.begin(), birds_.end(), isObject);
                 size_t index = std::distance(birds_.begin(), it1);
-                auto it = std::remove(birds_.begin(), birds_.end(), object_in_turn_);
+                auto it = std::remove_if(birds_.begin(), birds_.end(), isObject);
                 if (it != birds_.end()) {
                     birds_.erase(it);
                     // std::cout << index << std::endl;
                     for (size_t i = index; i < birds_.size(); ++i) {
                         b2Vec2 currentPos = birds_[i]->getBody()->GetPosition();
-                        birds_[i]->getBody()->SetTransform(b2Vec2(currentPos.x-0.4, currentPos.y), 0);
+                        birds_[i]->setTransform(b2Vec2(currentPos.x-0.4, currentPos.y), 0);
+                        awake_.add(birds_[i].get());
                         // std::cout << "bird on index " << index << " moved" << std::endl;
                     }
                 }
@@ -462,15 +483,13 @@
         std::pair<std::string, int> update(sf::Time deltaTime, sf::RenderWindow& window, sf::View& view) override {
             updatePhysics(deltaTime.asSeconds()); // Update the Box2D world
 
-            // update object positions (SFML)
-            for (auto bird : birds_) { bird->Update(); }
-            for (auto pig : pigs_) { pig->Update(); }
-            for (auto obstacle : obstacles_) { obstacle->Update(); }
-            if (star_)
+            // update positions (SFML) of the objects that moved, between the last two steps by the time left over
             {
-                star_->Update();
+                PROFILE_SCOPE(ProfileSection::Sync);
+                awake_.update(scheduler_.getAlpha());
             }
-            
+            PROFILE_GAUGE(ProfileCounter::Bodies, world_.GetBodyCount());
+            PROFILE_GAUGE(ProfileCounter::Contacts, world_.GetContactCount());
 
             return getReturn("");
         }
@@ -480,17 +499,18 @@
          */
         void render(sf::RenderWindow& window, sf::View& view) override {
             window.clear();
-            render_.renderBackground(window, "../src/imagefiles/level_background.png");
-            // Add graphic objects
-            render_.renderObstacle(window, *ground_);
-            render_.renderSlingShot(window, slingshot_);
+            // background, ground and slingshot come from a texture drawn once
+            render_.renderScenery(window, *ground_, slingshot_);
+            // the whole world layer is drawn with one call, without what is outside the view
+            render_.beginWorld(window);
             if (star_)
             {
-                render_.renderStar(window, *star_);
+                render_.batchObject(*star_);
             }
-            for (auto bird : birds_) { render_.renderBird(window, *bird); }
-            for (auto pig : pigs_) { render_.renderPig(window, *pig); }
-            for (auto obstacle : obstacles_) { render_.renderObstacle(window, *obstacle); }
+            for (auto bird : birds_) { render_.batchObject(*bird); }
+            for (auto pig : pigs_) { render_.batchObject(*pig); }
+            for (auto obstacle : obstacles_) { render_.batchObject(*obstacle); }
+            render_.renderWorld(window);
             for (auto button : buttons_) { render_.renderButton(window, *button); }
             render_.renderButton(window, *bin_button_);
             if (saved_) {
@@ -503,35 +523,28 @@
                 
                 //render.renderButton(window, *menu_button_);
             }
-            window.display();
         }
 
         /**
          * @brief Update the physics world of the player made level
-         * 
+         *
+         * At most 5 steps are run per frame, the time of any further steps is dropped.
          */
         void updatePhysics(double deltaTime) {
-        
-            double timeStep = 1.0f / 60.0f;
-            physicsTime_ += deltaTime;
-
-            while (physicsTime_ >= timeStep)
+            int steps = scheduler_.advance(deltaTime);
+            for (int i = 0; i < steps; i++)
             {
-                world_.Step(timeStep, 8, 3); // Updates the b2World by 1 "step"
-                physicsTime_ -= timeStep;
-            }
-            for (b2Body* body : bodiesToRemove_) {
-                Userdata* data = reinterpret_cast<Userdata*>(body->GetUserData().pointer);
-                if (data)
+                if (i == steps - 1)
                 {
-                    if (data->object)
-                    {
-                        // std::cout << data->objecttype << "data deleted" << std::endl;
-                        delete data; // userdata object have object attributes that need to be freed.
-                        world_.DestroyBody(body);
-                        // std::cout << "body destroyed" << std::endl;
-                    }
+                    // the objects are drawn between the transforms before and after the last step
+                    awake_.savePreviousTransforms();
                 }
+                PROFILE_SCOPE(ProfileSection::Physics);
+                world_.Step(scheduler_.getTimeStep(), 8, 3); // Updates the b2World by 1 "step"
+            }
+            // the userdata is part of the removed object, which may already be gone, so it is not read here
+            for (b2Body* body : bodiesToRemove_) {
+                world_.DestroyBody(body);
             }
             bodiesToRemove_.clear();
         }
@@ -541,15 +554,20 @@
     private:
         b2Vec2 gravity_;
         b2World world_;
-        std::shared_ptr<Object> object_in_turn_;
+        Object* object_in_turn_ = nullptr;     // object being dragged, owned by one of the vectors below
         Slingshot slingshot_;
         std::vector<std::shared_ptr<Button>> buttons_;
         std::vector<std::shared_ptr<Bird>> birds_;
         std::vector<std::shared_ptr<Pig>> pigs_;
         std::vector<std::shared_ptr<Obstacle>> obstacles_;
         std::shared_ptr<Ground> ground_;
+        std::shared_ptr<ObjectPool> pool_;  // objects added in the sandbox share the arena of the level
         bool dragging_ = false;
-        double physicsTime_ = 0;
+        FixedStepScheduler scheduler_;  // real time given to updatePhysics() in steps
+        AwakeSet awake_;                // objects whose drawn transform follows their body
+        AwakeListener awakeListener_{ awake_ };
+        ObjectPicker picker_;           // finds the object under the mouse
+        unsigned nextDrawOrder_ = 0;    // draw order of the next object added, later objects are on top
         std::shared_ptr<Button> buttonClicked_;
         bool clicked_ = false;
         sf::Vector2i pressPosition_; // To store the position of mouse press
@@ -564,7 +582,7 @@
         sf::Clock saveClock_; // clock to make the save heading appear for only a while
         std::vector<b2Body*> bodiesToRemove_;
         Render render_;
-        sf::SoundBuffer soundBuffer_;
+        std::shared_ptr<sf::SoundBuffer> soundBuffer_;
         sf::Sound sound_;
         sf::Music music_;
         b2Vec2 posOfBird_;
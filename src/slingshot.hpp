@@ -1,6 +1,7 @@
 #pragma once
 
 #include "bird.hpp"
+#include "assetcache.hpp"
 #include <memory>
 
 
@@ -14,15 +15,12 @@ public:
     ~Slingshot() = default;
 
     void createSprite() {
-        if (!texture_.loadFromFile("../src/imagefiles/slingshot.png")) {
-            // throw error
-            throw std::runtime_error("Error loading texture file for slingshot!");
-        }
-        sprite_.setTexture(texture_);
+        texture_ = AssetCache::getTexture("../src/imagefiles/slingshot.png");
+        sprite_.setTexture(*texture_);
         sf::FloatRect bounds = sprite_.getLocalBounds();
         sprite_.setOrigin(bounds.width / 2, bounds.height / 2);
-        float texture_x = static_cast<float>(texture_.getSize().x);
-        float texture_y = static_cast<float>(texture_.getSize().y);
+        float texture_x = static_cast<float>(texture_->getSize().x);
+        float texture_y = static_cast<float>(texture_->getSize().y);
         float x_scale = width_ / texture_x;
         float y_scale = height_ / texture_y;
         sprite_.setScale(x_scale, y_scale);
@@ -39,6 +37,8 @@ public:
 
     void setBird (std::shared_ptr<Bird>& bird) { bird_ = bird; }
 
+    void removeBird () { bird_ = nullptr; }
+
     void shoot() {}
 
     int getX() { return birdplace_.x; }
@@ -47,7 +47,7 @@ public:
 private:
     std::shared_ptr<Bird> bird_;
     sf::Sprite sprite_;
-    sf::Texture texture_;
+    std::shared_ptr<sf::Texture> texture_;
     float width_;
     float height_;
     sf::Vector2i birdplace_;
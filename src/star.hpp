@@ -12,6 +12,7 @@ public:
      * @param y 
      */
     Star(double x, double y) : Pig(1, x, y, 40, 40, "../src/soundfiles/star.wav", "../src/imagefiles/star.png", 1, 1, 0.1) {
+        material_ = Material::Star;
     }
 
     ~Star() {}
@@ -19,7 +20,7 @@ public:
     void setData() {
         auto* userdata = reinterpret_cast<Userdata*>(getBody()->GetUserData().pointer);
         if (userdata) {
-            userdata->objecttype = "star";
+            userdata->type = ObjectType::Star;
         }
     }
 };
\ No newline at end of file
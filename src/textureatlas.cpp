@@ -0,0 +1,126 @@
+#include "textureatlas.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    const unsigned kAtlasWidth = 2048;  // width of the packed texture
+    const unsigned kPadding = 2;        // empty pixels between packed images so they do not bleed into each other
+}
+
+void TextureAtlas::build(const std::string& directory, unsigned maxRegionSize) {
+    std::filesystem::path dir(directory);
+    if (!std::filesystem::is_directory(dir)) {
+        throw std::runtime_error("Failed opening the image directory " + directory + "!");
+    }
+
+    // load and shrink every image of the directory
+    std::vector<std::pair<std::string, sf::Image>> images;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        if (entry.path().extension() != ".png") {
+            continue;
+        }
+        std::string path = (dir / entry.path().filename()).generic_string();
+        sf::Image image;
+        if (!image.loadFromFile(path)) {
+            throw std::runtime_error("Error loading texture file: " + path + "!");
+        }
+        images.emplace_back(path, shrink(image, maxRegionSize));
+    }
+
+    // pack tallest images first into rows (shelves) of the atlas
+    std::sort(images.begin(), images.end(), [](const auto& a, const auto& b) {
+        return a.second.getSize().y > b.second.getSize().y;
+    });
+    std::vector<sf::Vector2u> positions;
+    unsigned x = kPadding;
+    unsigned y = kPadding;
+    unsigned shelfHeight = 0;
+    for (const auto& image : images) {
+        sf::Vector2u size = image.second.getSize();
+        if (x + size.x + kPadding > kAtlasWidth) {
+            x = kPadding;
+            y += shelfHeight + kPadding;
+            shelfHeight = 0;
+        }
+        positions.emplace_back(x, y);
+        x += size.x + kPadding;
+        shelfHeight = std::max(shelfHeight, size.y);
+    }
+    unsigned height = 1;
+    while (height < y + shelfHeight + kPadding) {
+        height *= 2;
+    }
+    if (kAtlasWidth > sf::Texture::getMaximumSize() || height > sf::Texture::getMaximumSize()) {
+        throw std::runtime_error("Texture atlas of " + directory + " does not fit into a texture!");
+    }
+
+    // copy the images into one big image and upload it
+    sf::Image atlas;
+    atlas.create(kAtlasWidth, height, sf::Color::Transparent);
+    regions_.clear();
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        const sf::Image& image = images[i].second;
+        atlas.copy(image, positions[i].x, positions[i].y);
+        // sample half a pixel inside the edges so smoothing does not pick up the padding
+        sf::Vector2u size = image.getSize();
+        regions_[images[i].first] = sf::FloatRect(positions[i].x + 0.5f, positions[i].y + 0.5f, size.x - 1.0f, size.y - 1.0f);
+    }
+    if (!texture_.loadFromImage(atlas)) {
+        throw std::runtime_error("Failed creating the texture atlas of " + directory + "!");
+    }
+    texture_.setSmooth(true);
+}
+
+const sf::FloatRect& TextureAtlas::getRegion(const std::string& path) const {
+    auto it = regions_.find(path);
+    if (it == regions_.end()) {
+        throw std::runtime_error("Texture " + path + " is not in the atlas!");
+    }
+    return it->second;
+}
+
+sf::Image TextureAtlas::shrink(const sf::Image& source, unsigned maxSize) {
+    sf::Vector2u size = source.getSize();
+    if (size.x <= maxSize && size.y <= maxSize) {
+        return source;
+    }
+    float factor = static_cast<float>(maxSize) / std::max(size.x, size.y);
+    unsigned width = std::max(1u, static_cast<unsigned>(size.x * factor));
+    unsigned height = std::max(1u, static_cast<unsigned>(size.y * factor));
+
+    // box filter: every target pixel is the average of the source pixels it covers.
+    // Colors are weighted by alpha so transparent pixels do not darken the edges.
+    const sf::Uint8* src = source.getPixelsPtr();
+    std::vector<sf::Uint8> pixels(width * height * 4);
+    for (unsigned ty = 0; ty < height; ++ty) {
+        unsigned y0 = ty * size.y / height;
+        unsigned y1 = std::max(y0 + 1, (ty + 1) * size.y / height);
+        for (unsigned tx = 0; tx < width; ++tx) {
+            unsigned x0 = tx * size.x / width;
+            unsigned x1 = std::max(x0 + 1, (tx + 1) * size.x / width);
+            unsigned long r = 0, g = 0, b = 0, a = 0, count = 0;
+            for (unsigned sy = y0; sy < y1; ++sy) {
+                const sf::Uint8* p = src + (sy * size.x + x0) * 4;
+                for (unsigned sx = x0; sx < x1; ++sx, p += 4) {
+                    r += p[0] * p[3];
+                    g += p[1] * p[3];
+                    b += p[2] * p[3];
+                    a += p[3];
+                    count++;
+                }
+            }
+            sf::Uint8* out = &pixels[(ty * width + tx) * 4];
+            if (a > 0) {
+                out[0] = static_cast<sf::Uint8>(r / a);
+                out[1] = static_cast<sf::Uint8>(g / a);
+                out[2] = static_cast<sf::Uint8>(b / a);
+            }
+            out[3] = static_cast<sf::Uint8>(a / count);
+        }
+    }
+    sf::Image result;
+    result.create(width, height, pixels.data());
+    return result;
+}
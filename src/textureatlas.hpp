@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <SFML/Graphics.hpp>
+
+/**
+ * @class TextureAtlas
+ * @brief Packs every image of a directory into one texture.
+ *
+ * Drawing all world objects from one texture lets the renderer put them into a single
+ * vertex array and issue one draw call instead of one call and texture bind per object.
+ * The source images are much larger than the objects ever appear on screen, so each image
+ * is scaled down so that its longer side is at most maxRegionSize pixels before packing.
+ */
+class TextureAtlas {
+public:
+    /**
+     * @brief Construct an empty atlas. Call build() before using it.
+     */
+    TextureAtlas() {}
+
+    /**
+     * @brief Load and pack all PNG images of a directory.
+     *
+     * Regions are keyed by the same path the objects use for their texture,
+     * e.g. "../src/imagefiles/wood.png".
+     *
+     * @param directory The directory containing the images.
+     * @param maxRegionSize The maximum width or height of one packed image in pixels.
+     * @throws std::runtime_error if the directory or an image cannot be read or the atlas does not fit into a texture.
+     */
+    void build(const std::string& directory, unsigned maxRegionSize = 256);
+
+    /**
+     * @brief Get the packed texture.
+     */
+    const sf::Texture& getTexture() const { return texture_; }
+
+    /**
+     * @brief Check if the image of the given path was packed into the atlas.
+     */
+    bool hasRegion(const std::string& path) const { return regions_.find(path) != regions_.end(); }
+
+    /**
+     * @brief Get the texture coordinates of a packed image.
+     *
+     * @param path The path of the original image file.
+     * @return The rectangle of the image inside the atlas texture, in pixels.
+     * @throws std::runtime_error if the image is not in the atlas.
+     */
+    const sf::FloatRect& getRegion(const std::string& path) const;
+
+private:
+    /**
+     * @brief Scale an image down so that it fits into maxSize x maxSize, keeping the aspect ratio.
+     */
+    static sf::Image shrink(const sf::Image& source, unsigned maxSize);
+
+    sf::Texture texture_;                                   // The packed texture
+    std::unordered_map<std::string, sf::FloatRect> regions_; // Location of each image inside the texture
+};
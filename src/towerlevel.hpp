@@ -0,0 +1,113 @@
+#pragma once
+
+#include <climits>
+#include <ostream>
+#include <random>
+#include <vector>
+
+/**
+ * @class TowerLevel
+ * @brief A level of block towers for stress testing, written in the format of the level files.
+ *
+ * A tower is 60 pixels wide. Its layers are a wood plank, two stone blocks side by side, or two
+ * glass pillars under a wood plank, and a pig sits on top of it. The towers stand in a row
+ * starting right of the slingshot, so large levels are wider than the window. The materials
+ * are drawn from a seeded generator, so the same options always build the same level.
+ * Used by angry_birds_levelgen, the tests and the benchmark.
+ */
+class TowerLevel {
+public:
+    static constexpr float kGroundTop = 598.0f;     // bottom of the first layer in pixels, like the bundled levels
+    static constexpr float kFirstTower = 700.0f;    // center of the first tower in pixels
+
+    struct Options {
+        int towers = 10;
+        int height = 10;            // layers per tower
+        long blocks = 0;            // build towers until this many blocks are placed, 0: use towers
+        int mix[3] = { 5, 3, 2 };   // relative share of wood, stone and glass layers
+        float spacing = 90.0f;      // distance between the centers of two towers in pixels
+        int birds = 3;
+        unsigned seed = 1;
+    };
+
+    struct Block {
+        const char* type;
+        float x, y;
+    };
+
+    /**
+     * @brief Build the towers and their pigs.
+     */
+    explicit TowerLevel(const Options& options) : options_(options) {
+        std::mt19937 random(options.seed);
+        std::discrete_distribution<int> material({ double(options.mix[0]), double(options.mix[1]), double(options.mix[2]) });
+        long remaining = options.blocks;
+        for (int tower = 0; options.blocks > 0 ? remaining > 0 : tower < options.towers; tower++) {
+            float x = kFirstTower + tower * options.spacing;
+            std::size_t before = blocks_.size();
+            float top = buildTower(x, options.blocks > 0 ? remaining : LONG_MAX, material, random);
+            remaining -= static_cast<long>(blocks_.size() - before);
+            pigs_.push_back(Block{ "Normal", x, top - 15 });
+        }
+    }
+
+    /**
+     * @brief Write the level in the format of the level files.
+     */
+    void write(std::ostream& out) const {
+        out << "Birds\n";
+        for (int i = 0; i < options_.birds; i++) {
+            out << (i % 3 == 2 ? "Yellow" : "Red") << "\n";
+        }
+        out << "\nPigs\n";
+        for (const Block& pig : pigs_) {
+            out << pig.type << " " << pig.x << " " << pig.y << "\n";
+        }
+        out << "\nObstacles\n";
+        for (const Block& block : blocks_) {
+            out << block.type << " " << block.x << " " << block.y << "\n";
+        }
+    }
+
+    const std::vector<Block>& getBlocks() const { return blocks_; }
+    const std::vector<Block>& getPigs() const { return pigs_; }   // one on each tower
+
+private:
+    // Stacks the layers of one tower, returns the top of the tower in pixels.
+    float buildTower(float x, long maxBlocks, std::discrete_distribution<int>& material, std::mt19937& random) {
+        float top = kGroundTop;
+        for (int layer = 0; layer < options_.height && maxBlocks > 0; layer++) {
+            switch (material(random)) {
+                case 0: {
+                    blocks_.push_back(Block{ "Wood", x, top - 5 });
+                    top -= 10;
+                    maxBlocks -= 1;
+                    break;
+                }
+                case 1: {
+                    blocks_.push_back(Block{ "Stone", x - 15, top - 15 });
+                    blocks_.push_back(Block{ "Stone", x + 15, top - 15 });
+                    top -= 30;
+                    maxBlocks -= 2;
+                    break;
+                }
+                default: {
+                    // pillars cannot carry anything narrower than the tower, so they are always capped
+                    blocks_.push_back(Block{ "Glass", x - 25, top - 20 });
+                    blocks_.push_back(Block{ "Glass", x + 25, top - 20 });
+                    top -= 40;
+                    blocks_.push_back(Block{ "Wood", x, top - 5 });
+                    top -= 10;
+                    maxBlocks -= 3;
+                    layer++;
+                    break;
+                }
+            }
+        }
+        return top;
+    }
+
+    Options options_;
+    std::vector<Block> blocks_;
+    std::vector<Block> pigs_;
+};
@@ -0,0 +1,59 @@
+#include "tracer.hpp"
+#include <fstream>
+#include <stdexcept>
+
+Tracer& Tracer::get() {
+    static Tracer tracer;
+    return tracer;
+}
+
+void Tracer::start(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    path_ = path;
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::write() {
+    if (!enabled_.exchange(false)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ofstream file(path_);
+    if (!file) {
+        throw std::runtime_error("Failed opening the file " + path_ + " for writing!");
+    }
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (const std::unique_ptr<Buffer>& buffer : buffers_) {
+        for (const Event& event : buffer->events) {
+            file << (first ? "" : ",\n") << "{\"name\":\"" << event.name << "\",\"ph\":\"" << event.phase
+                 << "\",\"ts\":" << event.start << ",\"pid\":1,\"tid\":" << buffer->thread;
+            if (event.phase == 'X') {
+                file << ",\"dur\":" << event.duration;
+            }
+            else {
+                file << ",\"s\":\"t\"";     // a moment is drawn on its thread only
+            }
+            file << "}";
+            first = false;
+        }
+        buffer->events.clear();
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    if (!file) {
+        throw std::runtime_error("Failed writing the file " + path_ + "!");
+    }
+}
+
+Tracer::Buffer& Tracer::threadBuffer() {
+    // the buffer lives in buffers_, so it outlives its thread until write()
+    thread_local Buffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers_.push_back(std::make_unique<Buffer>());
+        buffer = buffers_.back().get();
+        buffer->thread = static_cast<int>(buffers_.size());
+        buffer->events.reserve(4096);
+    }
+    return *buffer;
+}
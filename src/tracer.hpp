@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class Tracer
+ * @brief Records nested zones of the game as a Chrome trace-event JSON file.
+ *
+ * The file opens in chrome://tracing or ui.perfetto.dev and shows each zone as a bar on the
+ * timeline of its thread, e.g. a frame with its update and physics steps inside, or the
+ * construction of a LevelState with its level file and textures.
+ *
+ * Every thread appends to a buffer of its own without taking a lock. The lock is only taken
+ * when a thread records its first event and when write() collects the buffers, which must
+ * happen after the other recording threads have finished. A buffer stops recording after
+ * kMaxEvents events, so a forgotten trace cannot grow without bounds.
+ *
+ * Zone names must outlive the tracer, string literals are used everywhere. Nothing is
+ * recorded until start(), and without ANGRY_BIRDS_PROFILER defined the macros are empty.
+ */
+class Tracer {
+public:
+    static constexpr std::size_t kMaxEvents = 1 << 20;     // events per thread, about 32 MB
+
+    /**
+     * @brief Get the tracer of the game, used by the macros.
+     */
+    static Tracer& get();
+
+    /**
+     * @brief Start recording, the events are written to a file by write().
+     *
+     * @param path The JSON file to write.
+     */
+    void start(const std::string& path);
+
+    /**
+     * @brief Check if events are being recorded.
+     */
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Stop recording and write every event recorded so far, nothing happens if not started.
+     *
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void write();
+
+    /**
+     * @brief Record a zone of the calling thread.
+     *
+     * @param name Name of the zone.
+     * @param start When the zone began, from now().
+     * @param end When the zone ended, from now().
+     */
+    void zone(const char* name, std::int64_t start, std::int64_t end) { record(name, start, end - start, 'X'); }
+
+    /**
+     * @brief Record a moment of the calling thread, e.g. a state change.
+     */
+    void instant(const char* name) { record(name, now(), 0, 'i'); }
+
+    /**
+     * @brief Get the time since the tracer was created in microseconds.
+     */
+    std::int64_t now() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - epoch_).count();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Event {
+        const char* name;
+        std::int64_t start;     // microseconds
+        std::int64_t duration;
+        char phase;             // 'X' for a zone, 'i' for a moment
+    };
+
+    struct Buffer {
+        int thread;
+        std::vector<Event> events;
+    };
+
+    void record(const char* name, std::int64_t start, std::int64_t duration, char phase) {
+        Buffer& buffer = threadBuffer();
+        if (buffer.events.size() < kMaxEvents) {
+            buffer.events.push_back(Event{ name, start, duration, phase });
+        }
+    }
+
+    /**
+     * @brief Get the buffer of the calling thread, registered on its first event.
+     */
+    Buffer& threadBuffer();
+
+    Clock::time_point epoch_ = Clock::now();
+    std::atomic<bool> enabled_{ false };
+    std::string path_;
+    std::mutex mutex_;                              // guards buffers_
+    std::vector<std::unique_ptr<Buffer>> buffers_;  // one for each thread that recorded an event
+};
+
+/**
+ * @class TraceZone
+ * @brief Records a zone from its construction until it goes out of scope.
+ */
+class TraceZone {
+public:
+    explicit TraceZone(const char* name) : name_(Tracer::get().isEnabled() ? name : nullptr) {
+        if (name_) { start_ = Tracer::get().now(); }
+    }
+
+    ~TraceZone() {
+        if (name_ && Tracer::get().isEnabled()) { Tracer::get().zone(name_, start_, Tracer::get().now()); }
+    }
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    const char* name_;      // nullptr if the tracer was not recording
+    std::int64_t start_ = 0;
+};
+
+#ifdef ANGRY_BIRDS_PROFILER
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(traceZone_, __LINE__)(name)
+#define TRACE_INSTANT(name) do { if (Tracer::get().isEnabled()) { Tracer::get().instant(name); } } while (0)
+#else
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_INSTANT(name) ((void)0)
+#endif
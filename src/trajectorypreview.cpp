@@ -0,0 +1,133 @@
+#include "trajectorypreview.hpp"
+#include <algorithm>
+
+std::vector<sf::Vector2f> TrajectoryPreview::arc(sf::Vector2f start, b2Vec2 velocity, float groundY, float levelWidth) {
+    // Box2D steps velocity first, then position: after n steps of length h
+    // x = x0 + v0 * t + g * t * (t + h) / 2 where t = n * h
+    const float h = LevelSimulation::kTimeStep;
+    const float g = LevelSimulation::kGravity;
+    std::vector<sf::Vector2f> points;
+    for (int n = kStepsPerPoint; static_cast<int>(points.size()) < kMaxPoints; n += kStepsPerPoint) {
+        float t = n * h;
+        sf::Vector2f point(start.x + 100.0f * velocity.x * t, start.y + 100.0f * (velocity.y * t + 0.5f * g * t * (t + h)));  // Convert meters to pixels
+        if (point.x < 0 || point.x > levelWidth || point.y > groundY) {
+            break;
+        }
+        points.push_back(point);
+    }
+    return points;
+}
+
+void TrajectoryPreview::toggleMode() {
+    mode_ = mode_ == Mode::Arc ? Mode::Simulated : Mode::Arc;
+    if (mode_ == Mode::Simulated && shadow_ && !arc_.empty()) {
+        pending_ = true;
+        refresh();
+    }
+    else {
+        hasImpact_ = false;
+        simulated_ = false;
+        points_ = arc_;
+    }
+}
+
+void TrajectoryPreview::begin(LevelSimulation& simulation, Bird& bird) {
+    clear();
+    groundY_ = simulation.getGround()->getY() - simulation.getGround()->getHeight() / 2;
+    levelWidth_ = simulation.getLevelWidth();
+    shadow_ = std::make_unique<b2World>(b2Vec2(0.0f, LevelSimulation::kGravity));
+    // everything the bird can hit stays where it is while aiming, so it is copied as static bodies
+    for (b2Body* body = simulation.getWorld().GetBodyList(); body; body = body->GetNext()) {
+        if (!body->IsEnabled() || body == bird.getBody()) {
+            continue;
+        }
+        b2BodyDef bodyDef;
+        bodyDef.type = b2_staticBody;
+        bodyDef.position = body->GetPosition();
+        bodyDef.angle = body->GetAngle();
+        b2Body* copy = shadow_->CreateBody(&bodyDef);
+        for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+            if (!fixture->IsSensor()) {
+                copy->CreateFixture(fixture->GetShape(), 0);
+            }
+        }
+    }
+    // the bird flies like in the level, without rotating before the first impact
+    b2BodyDef bodyDef;
+    bodyDef.type = b2_dynamicBody;
+    bodyDef.fixedRotation = true;
+    shadowBird_ = shadow_->CreateBody(&bodyDef);
+    for (b2Fixture* fixture = bird.getBody()->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+        b2FixtureDef fixtureDef;
+        fixtureDef.shape = fixture->GetShape();
+        fixtureDef.density = fixture->GetDensity();
+        fixtureDef.friction = fixture->GetFriction();
+        fixtureDef.restitution = fixture->GetRestitution();
+        shadowBird_->CreateFixture(&fixtureDef);
+    }
+}
+
+void TrajectoryPreview::update(sf::Vector2f start, b2Vec2 velocity) {
+    start_ = start;
+    velocity_ = velocity;
+    arc_ = arc(start, velocity, groundY_, levelWidth_);
+    if (mode_ == Mode::Simulated && shadow_) {
+        b2Vec2 change = velocity - simulatedVelocity_;
+        if (simulated_ && change.Length() < 0.05f) {
+            pending_ = false;   // the cached impact is still good
+        }
+        else if (std::chrono::steady_clock::now() - lastSimulation_ < kThrottle) {
+            pending_ = true;    // keep the previous impact until refresh() runs the simulation
+        }
+        else {
+            simulate();
+        }
+    }
+    points_ = arc_;
+    if (mode_ == Mode::Simulated && hasImpact_) {
+        points_.resize(std::min(points_.size(), static_cast<std::size_t>(impactStep_ / kStepsPerPoint)));
+    }
+}
+
+void TrajectoryPreview::refresh() {
+    if (pending_ && shadow_ && std::chrono::steady_clock::now() - lastSimulation_ >= kThrottle) {
+        update(start_, velocity_);
+    }
+}
+
+void TrajectoryPreview::clear() {
+    arc_.clear();
+    points_.clear();
+    shadow_.reset();
+    shadowBird_ = nullptr;
+    hasImpact_ = false;
+    simulated_ = false;
+    pending_ = false;
+}
+
+void TrajectoryPreview::simulate() {
+    lastSimulation_ = std::chrono::steady_clock::now();
+    simulatedVelocity_ = velocity_;
+    simulated_ = true;
+    pending_ = false;
+    hasImpact_ = false;
+    shadowBird_->SetTransform(b2Vec2(start_.x / 100.0f, start_.y / 100.0f), 0);   // Convert to Box2D unit
+    shadowBird_->SetLinearVelocity(velocity_);
+    shadowBird_->SetAwake(true);
+    for (int step = 1; step <= kMaxImpactSteps; step++) {
+        shadow_->Step(LevelSimulation::kTimeStep, 8, 3);
+        // only the bird is dynamic, so every touching contact is the bird hitting something
+        for (b2Contact* contact = shadow_->GetContactList(); contact; contact = contact->GetNext()) {
+            if (contact->IsTouching()) {
+                hasImpact_ = true;
+                break;
+            }
+        }
+        if (hasImpact_) {
+            b2Vec2 position = shadowBird_->GetPosition();
+            impact_ = sf::Vector2f(position.x * 100.0f, position.y * 100.0f);   // Convert meters to pixels
+            impactStep_ = step;
+            return;
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+#include <box2d/box2d.h>
+#include "levelsimulation.hpp"
+
+/**
+ * @class TrajectoryPreview
+ * @brief Predicted flight path of the bird while it is pulled back in the slingshot.
+ *
+ * The path is a closed-form ballistic arc, cheap enough to recompute on every mouse move.
+ * In the Simulated mode the first impact is also searched for by flying a copy of the bird
+ * through a shadow world, a static copy of the level taken when aiming starts. The forward
+ * simulation is throttled and its result cached, the arc is cut at the impact.
+ */
+class TrajectoryPreview {
+public:
+    enum class Mode { Arc, Simulated };
+
+    static constexpr int kStepsPerPoint = 3;        // physics steps between two dots of the arc
+    static constexpr int kMaxPoints = 60;           // dots of one second of flight
+    static constexpr int kMaxImpactSteps = 120;     // longest forward simulation, two seconds
+    static constexpr std::chrono::milliseconds kThrottle = std::chrono::milliseconds(30);   // shortest time between two forward simulations
+
+    /**
+     * @brief Compute the closed-form arc of a launched bird.
+     *
+     * Uses the same semi-implicit Euler steps as Box2D, so the dots lie on the path the bird
+     * flies until it hits something. The arc ends when it leaves the level or goes below the ground.
+     *
+     * @param start Launch position in pixels.
+     * @param velocity Launch velocity in meters per second.
+     * @param groundY Top of the ground in pixels.
+     * @param levelWidth Width of the level in pixels.
+     * @return Positions in pixels, one every kStepsPerPoint steps.
+     */
+    static std::vector<sf::Vector2f> arc(sf::Vector2f start, b2Vec2 velocity, float groundY, float levelWidth = LevelSimulation::kLevelWidth);
+
+    Mode getMode() const { return mode_; }
+
+    /**
+     * @brief Switch between the Arc and the Simulated mode.
+     */
+    void toggleMode();
+
+    /**
+     * @brief Take a static copy of the level for the forward simulation of the Simulated mode.
+     *
+     * Called when aiming starts. Destroyed objects, the star and the bird itself are left out.
+     *
+     * @param simulation The level.
+     * @param bird The bird that is aimed.
+     */
+    void begin(LevelSimulation& simulation, Bird& bird);
+
+    /**
+     * @brief Recompute the preview for a new aim.
+     *
+     * @param start Position of the bird in pixels.
+     * @param velocity Velocity the bird would be launched with.
+     */
+    void update(sf::Vector2f start, b2Vec2 velocity);
+
+    /**
+     * @brief Run a forward simulation that was throttled, called every frame while aiming.
+     */
+    void refresh();
+
+    /**
+     * @brief Forget the preview and the shadow world, called when the bird is released.
+     */
+    void clear();
+
+    /**
+     * @brief Get the dots of the predicted path in pixels.
+     */
+    const std::vector<sf::Vector2f>& getPoints() const { return points_; }
+
+    /**
+     * @brief Check if the forward simulation found where the bird hits first.
+     */
+    bool hasImpact() const { return hasImpact_; }
+
+    /**
+     * @brief Get the position of the bird when it hits first, in pixels.
+     */
+    sf::Vector2f getImpact() const { return impact_; }
+
+private:
+    /**
+     * @brief Fly the shadow bird and cut the arc at its first contact.
+     */
+    void simulate();
+
+    Mode mode_ = Mode::Simulated;
+    std::vector<sf::Vector2f> arc_;             // closed-form arc of the current aim
+    std::vector<sf::Vector2f> points_;          // arc_ cut at the impact
+    float groundY_ = 0;
+    float levelWidth_ = LevelSimulation::kLevelWidth;
+    sf::Vector2f start_;
+    b2Vec2 velocity_;
+    bool hasImpact_ = false;
+    sf::Vector2f impact_;
+    int impactStep_ = 0;                        // step of the impact, the arc is cut there
+
+    std::unique_ptr<b2World> shadow_;           // static copy of the level, nullptr when not aiming
+    b2Body* shadowBird_ = nullptr;
+    b2Vec2 simulatedVelocity_;                  // velocity of the cached forward simulation
+    bool simulated_ = false;                    // a forward simulation has been run for this aim
+    bool pending_ = false;                      // the aim changed while throttled
+    std::chrono::steady_clock::time_point lastSimulation_;
+};
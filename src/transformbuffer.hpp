@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <box2d/box2d.h>
+
+class Object;
+
+/**
+ * @class TransformBuffer
+ * @brief The drawn transforms of the objects of a level, kept as structure of arrays.
+ *
+ * Each object that moves gets a slot. After a physics step the bodies of the awake objects
+ * are copied in, in meters and radians, and toPixels() interpolates every slot and converts
+ * it to pixels and degrees in one loop over plain float arrays, which the compiler can
+ * vectorize. The renderer reads getX(), getY() and getAngle() directly, so drawing does
+ * not touch the objects for their positions.
+ *
+ * Each slot also caches the radius of its object, so the renderer can cull slots outside
+ * the view from the arrays alone.
+ *
+ * The previous and the current transform of a slot are equal while its body is at rest,
+ * then the slot is drawn at its current transform whatever alpha is.
+ */
+class TransformBuffer {
+public:
+    /**
+     * @brief Remove every slot, keeping the allocated memory.
+     */
+    void clear() {
+        objects_.clear();
+        radius_.clear();
+        prevX_.clear(); prevY_.clear(); prevAngle_.clear();
+        curX_.clear(); curY_.clear(); curAngle_.clear();
+        x_.clear(); y_.clear(); angle_.clear();
+    }
+
+    /**
+     * @brief Add a slot at the transform of a body.
+     *
+     * @param object The object the slot belongs to, drawn with the transform of the slot.
+     * @param body The body of the object.
+     * @param radius Radius of a circle around the drawn object in pixels, used to cull it.
+     * @return The index of the slot.
+     */
+    int add(const Object* object, const b2Body& body, float radius) {
+        objects_.push_back(object);
+        radius_.push_back(radius);
+        prevX_.push_back(0); prevY_.push_back(0); prevAngle_.push_back(0);
+        curX_.push_back(0); curY_.push_back(0); curAngle_.push_back(0);
+        x_.push_back(0); y_.push_back(0); angle_.push_back(0);
+        int slot = static_cast<int>(objects_.size() - 1);
+        place(slot, body);
+        return slot;
+    }
+
+    /**
+     * @brief Move a slot to the transform of a body without interpolating, e.g. when the body is moved by hand.
+     *
+     * The drawn transform is updated at once, not by the next toPixels().
+     */
+    void place(int slot, const b2Body& body) {
+        savePrevious(slot, body);
+        store(slot, body);
+        x_[slot] = curX_[slot] * kPixelsPerMeter;
+        y_[slot] = curY_[slot] * kPixelsPerMeter;
+        angle_[slot] = curAngle_[slot] * kDegreesPerRadian;
+    }
+
+    /**
+     * @brief Copy the transform of a body into a slot as its transform before the next step.
+     */
+    void savePrevious(int slot, const b2Body& body) {
+        const b2Vec2& position = body.GetPosition();
+        prevX_[slot] = position.x;
+        prevY_[slot] = position.y;
+        prevAngle_[slot] = body.GetAngle();
+    }
+
+    /**
+     * @brief Copy the transform of a body into a slot as its current transform.
+     */
+    void store(int slot, const b2Body& body) {
+        const b2Vec2& position = body.GetPosition();
+        curX_[slot] = position.x;
+        curY_[slot] = position.y;
+        curAngle_[slot] = body.GetAngle();
+    }
+
+    /**
+     * @brief Interpolate every slot and convert it to pixels and degrees.
+     *
+     * @param alpha 0 for the transforms before the last step, 1 for the current ones.
+     */
+    void toPixels(float alpha) {
+        const std::size_t n = objects_.size();
+        const float* prevX = prevX_.data(); const float* prevY = prevY_.data(); const float* prevAngle = prevAngle_.data();
+        const float* curX = curX_.data(); const float* curY = curY_.data(); const float* curAngle = curAngle_.data();
+        float* x = x_.data(); float* y = y_.data(); float* angle = angle_.data();
+        // no branches or calls, one pass the compiler turns into SIMD instructions
+        for (std::size_t i = 0; i < n; i++) {
+            x[i] = (prevX[i] + alpha * (curX[i] - prevX[i])) * kPixelsPerMeter;
+            y[i] = (prevY[i] + alpha * (curY[i] - prevY[i])) * kPixelsPerMeter;
+            angle[i] = (prevAngle[i] + alpha * (curAngle[i] - prevAngle[i])) * kDegreesPerRadian;
+        }
+    }
+
+    /**
+     * @brief Get the number of slots.
+     */
+    std::size_t size() const { return objects_.size(); }
+
+    /**
+     * @brief Get the object drawn with a slot.
+     */
+    const Object* getObject(std::size_t slot) const { return objects_[slot]; }
+
+    /**
+     * @brief Get the drawn X-coordinates of the slots in pixels, updated by toPixels().
+     */
+    const float* getX() const { return x_.data(); }
+
+    /**
+     * @brief Get the drawn Y-coordinates of the slots in pixels, updated by toPixels().
+     */
+    const float* getY() const { return y_.data(); }
+
+    /**
+     * @brief Get the drawn rotations of the slots in degrees clockwise, updated by toPixels().
+     */
+    const float* getAngle() const { return angle_.data(); }
+
+    /**
+     * @brief Get the radii of the circles around the drawn objects in pixels, they do not change.
+     */
+    const float* getRadius() const { return radius_.data(); }
+
+private:
+    static constexpr float kPixelsPerMeter = 100.0f;
+    static constexpr float kDegreesPerRadian = 180.0f / b2_pi;
+
+    std::vector<const Object*> objects_;
+    std::vector<float> radius_;                       // bounds of the drawn objects, whatever their rotation
+    std::vector<float> prevX_, prevY_, prevAngle_;    // body transforms before the last step, meters and radians
+    std::vector<float> curX_, curY_, curAngle_;       // body transforms after the last step
+    std::vector<float> x_, y_, angle_;                // drawn transforms, pixels and degrees
+};
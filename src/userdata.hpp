@@ -1,10 +1,30 @@
 #pragma once
 
-#include "object.hpp"
-#include <string>
+#include <cstdint>
+#include "objecthandle.hpp"
 
+class Object;
+
+/**
+ * @brief Kind of an Object as the collision listener sees it.
+ */
+enum class ObjectType : std::uint8_t {
+    Bird,
+    Pig,
+    Obstacle,
+    Ground,
+    Star,
+    Count       // number of types, not a type
+};
+
+/**
+ * @brief Data attached to a Box2D body, it identifies the Object of the body.
+ *
+ * Every Object holds its own Userdata, so it lives exactly as long as the Object.
+ */
 struct Userdata
 {
-    std::string objecttype;
+    ObjectType type = ObjectType::Obstacle;
     Object* object = nullptr;
-};
\ No newline at end of file
+    ObjectHandle handle;        // handle of the object in the table of its level
+};
@@ -0,0 +1,79 @@
+#include "voicepool.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+
+VoicePool::VoicePool(std::size_t voices, float volume) : volume_(volume), voices_(voices) {}
+
+void VoicePool::request(const sf::SoundBuffer& buffer, float strength, int priority) {
+    // a collapse hits the same material many times in one frame, it is played once
+    for (Request& queued : queue_) {
+        if (queued.buffer == &buffer) {
+            queued.strength = std::max(queued.strength, strength);
+            queued.priority = std::max(queued.priority, priority);
+            return;
+        }
+    }
+    queue_.push_back(Request{ &buffer, strength, priority });
+}
+
+void VoicePool::flush() {
+    std::sort(queue_.begin(), queue_.end(), [](const Request& a, const Request& b) {
+        return a.priority != b.priority ? a.priority > b.priority : a.strength > b.strength;
+    });
+    for (const Request& request : queue_) {
+        Voice* voice = findVoice(request);
+        if (!voice) {
+            break;      // the rest of the queue is not louder or more important
+        }
+        voice->sound.stop();
+        voice->sound.setBuffer(*request.buffer);
+        voice->sound.setVolume(volume_ * std::clamp(request.strength / kFullStrength, 0.2f, 1.0f));
+        voice->sound.play();
+        PROFILE_COUNT(ProfileCounter::SoundsStarted, 1);
+        voice->strength = request.strength;
+        voice->priority = request.priority;
+    }
+    queue_.clear();
+}
+
+void VoicePool::stopAll() {
+    for (Voice& voice : voices_) {
+        voice.sound.stop();
+    }
+    queue_.clear();
+}
+
+std::size_t VoicePool::getPlaying() const {
+    return std::count_if(voices_.begin(), voices_.end(), [](const Voice& voice) {
+        return voice.sound.getStatus() == sf::Sound::Playing;
+    });
+}
+
+float VoicePool::remainingStrength(const Voice& voice) {
+    const sf::SoundBuffer* buffer = voice.sound.getBuffer();
+    float duration = buffer ? buffer->getDuration().asSeconds() : 0;
+    if (duration <= 0) {
+        return 0;
+    }
+    return voice.strength * (1.0f - voice.sound.getPlayingOffset().asSeconds() / duration);
+}
+
+VoicePool::Voice* VoicePool::findVoice(const Request& request) {
+    Voice* quietest = nullptr;
+    float quietestStrength = 0;
+    for (Voice& voice : voices_) {
+        if (voice.sound.getStatus() != sf::Sound::Playing) {
+            return &voice;
+        }
+        float strength = remainingStrength(voice);
+        if (voice.priority <= request.priority && (!quietest || strength < quietestStrength)) {
+            quietest = &voice;
+            quietestStrength = strength;
+        }
+    }
+    // steal only from a sound that is quieter by now, or less important
+    if (quietest && (quietest->priority < request.priority || quietestStrength < request.strength)) {
+        return quietest;
+    }
+    return nullptr;
+}
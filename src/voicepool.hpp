@@ -0,0 +1,91 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <SFML/Audio.hpp>
+
+/**
+ * @class VoicePool
+ * @brief Fixed set of sf::Sound voices shared by all collision and launch sounds of a level.
+ *
+ * Sounds are requested during the frame and started together by flush(). Requests for the
+ * same sound in one frame are merged into the loudest one. When every voice is busy, a new
+ * sound takes the voice of the quietest playing sound of a lower or equal priority, or is
+ * dropped if all playing sounds matter more. The number of OpenAL sources and play() calls
+ * per frame is bounded by the number of voices, however many objects a level has.
+ *
+ * The pool is meant to be used from the main thread only.
+ */
+class VoicePool {
+public:
+    static constexpr std::size_t kVoices = 16;          // voices of a level, well below the usual OpenAL source limit
+    static constexpr float kFullStrength = 8.0f;        // impact speed in m/s played at full volume
+
+    /**
+     * @brief Construct a pool.
+     *
+     * @param voices Number of sounds that can play at the same time.
+     * @param volume Volume of a sound of full strength, 0 to 100.
+     */
+    explicit VoicePool(std::size_t voices = kVoices, float volume = 40);
+
+    /**
+     * @brief Queue a sound to be started by the next flush().
+     *
+     * @param buffer The sound, the caller keeps it loaded while the pool plays it.
+     * @param strength How hard the impact was in m/s, sets the volume and the rank when stealing.
+     * @param priority Sounds of a higher priority are never stolen by lower ones.
+     */
+    void request(const sf::SoundBuffer& buffer, float strength, int priority = 0);
+
+    /**
+     * @brief Start the queued sounds, loudest and most important first, and empty the queue.
+     */
+    void flush();
+
+    /**
+     * @brief Stop every voice and forget the queued sounds.
+     */
+    void stopAll();
+
+    /**
+     * @brief Get the number of sounds waiting for flush().
+     */
+    std::size_t getQueued() const { return queue_.size(); }
+
+    /**
+     * @brief Get the number of voices playing.
+     */
+    std::size_t getPlaying() const;
+
+    std::size_t getVoiceCount() const { return voices_.size(); }
+
+private:
+    struct Request {
+        const sf::SoundBuffer* buffer;
+        float strength;
+        int priority;
+    };
+
+    struct Voice {
+        sf::Sound sound;
+        float strength = 0;
+        int priority = 0;
+    };
+
+    /**
+     * @brief Get how loud a voice still is, its strength fades out over the length of the sound.
+     */
+    static float remainingStrength(const Voice& voice);
+
+    /**
+     * @brief Find a stopped voice or the voice the request may steal.
+     *
+     * @return nullptr if the request should be dropped.
+     */
+    Voice* findVoice(const Request& request);
+
+    float volume_;
+    std::vector<Request> queue_;
+    std::vector<Voice> voices_;
+};
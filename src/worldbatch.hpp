@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cmath>
+#include <SFML/Graphics.hpp>
+#include "object.hpp"
+#include "textureatlas.hpp"
+#include "profiler.hpp"
+
+/**
+ * @class WorldBatch
+ * @brief Collects the quads of world objects into one vertex array.
+ *
+ * Every object added during a frame becomes two textured triangles that sample the
+ * shared texture atlas, so the whole world layer is drawn with one draw call.
+ * Objects outside the cull rectangle, usually the view, are not added at all.
+ * The vertex array keeps its memory between frames.
+ */
+class WorldBatch {
+public:
+    /**
+     * @brief Construct a batch drawing from the given atlas.
+     *
+     * @param atlas The atlas containing the textures of the objects.
+     */
+    WorldBatch(const TextureAtlas& atlas) : atlas_(atlas), vertices_(sf::Triangles) {}
+
+    /**
+     * @brief Remove all quads, keeping the allocated memory, and reset the culled count.
+     */
+    void clear() {
+        vertices_.clear();
+        culled_ = 0;
+    }
+
+    /**
+     * @brief Skip objects outside a rectangle from now on.
+     *
+     * @param view The visible part of the world in pixels.
+     */
+    void setCullRect(const sf::FloatRect& view) { view_ = view; }
+
+    /**
+     * @brief Check if a circle overlaps the cull rectangle, counting it as culled if not.
+     *
+     * @param center The center of the circle in pixels.
+     * @param radius The radius of the circle in pixels.
+     */
+    bool visible(sf::Vector2f center, float radius) {
+        if (center.x + radius < view_.left || center.x - radius > view_.left + view_.width
+            || center.y + radius < view_.top || center.y - radius > view_.top + view_.height) {
+            culled_++;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Add the quad of an object at its current position and rotation, unless it is outside the cull rectangle.
+     *
+     * @param object The object to add.
+     */
+    void add(const Object& object) {
+        sf::Vector2f center(object.getX(), object.getY());
+        if (visible(center, std::hypot(object.getWidth(), object.getHeight()) / 2.0f)) {
+            add(object, center, object.getAngle());
+        }
+    }
+
+    /**
+     * @brief Add the quad of an object at a given position and rotation.
+     *
+     * @param object The object, gives the texture and the size of the quad.
+     * @param center The center of the quad in pixels.
+     * @param degrees The rotation of the quad in degrees, clockwise.
+     */
+    void add(const Object& object, sf::Vector2f center, float degrees) {
+        const sf::FloatRect& region = atlas_.getRegion(object.getTextureFilePath());
+        float angle = degrees * b2_pi / 180.0f;
+        float c = std::cos(angle);
+        float s = std::sin(angle);
+        float hw = object.getWidth() / 2.0f;
+        float hh = object.getHeight() / 2.0f;
+
+        // corners rotated around the center of the object, clockwise from the top left
+        sf::Vector2f corners[4] = {
+            center + sf::Vector2f(-hw * c + hh * s, -hw * s - hh * c),
+            center + sf::Vector2f( hw * c + hh * s,  hw * s - hh * c),
+            center + sf::Vector2f( hw * c - hh * s,  hw * s + hh * c),
+            center + sf::Vector2f(-hw * c - hh * s, -hw * s + hh * c)
+        };
+        sf::Vector2f texCoords[4] = {
+            sf::Vector2f(region.left, region.top),
+            sf::Vector2f(region.left + region.width, region.top),
+            sf::Vector2f(region.left + region.width, region.top + region.height),
+            sf::Vector2f(region.left, region.top + region.height)
+        };
+        static const int order[6] = { 0, 1, 2, 0, 2, 3 };
+        for (int i : order) {
+            vertices_.append(sf::Vertex(corners[i], texCoords[i]));
+        }
+    }
+
+    /**
+     * @brief Draw every added quad with one draw call.
+     *
+     * @param target The window or texture to draw to.
+     */
+    void draw(sf::RenderTarget& target) const {
+        if (vertices_.getVertexCount() > 0) {
+            target.draw(vertices_, sf::RenderStates(&atlas_.getTexture()));
+            PROFILE_COUNT(ProfileCounter::DrawCalls, 1);
+        }
+    }
+
+    /**
+     * @brief Get the number of objects currently in the batch.
+     */
+    std::size_t size() const { return vertices_.getVertexCount() / 6; }
+
+    /**
+     * @brief Get the number of objects skipped by the cull rectangle since the last clear().
+     */
+    std::size_t getCulled() const { return culled_; }
+
+private:
+    const TextureAtlas& atlas_;     // Atlas the texture coordinates point into
+    sf::VertexArray vertices_;      // Two triangles per object
+    sf::FloatRect view_ = sf::FloatRect(-1e9f, -1e9f, 2e9f, 2e9f);   // cull rectangle, everything until set
+    std::size_t culled_ = 0;
+};
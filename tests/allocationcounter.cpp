@@ -0,0 +1,29 @@
+#include "allocationcounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global operator new of the test executable to count allocations.
+
+namespace {
+    std::atomic<std::size_t> allocations{ 0 };
+
+    void* allocate(std::size_t size) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        if (void* memory = std::malloc(size ? size : 1)) {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+std::size_t allocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Get the number of times operator new has been called in the test executable so far.
+ *
+ * Box2D allocates with malloc through its own block allocator, only C++ allocations are counted.
+ */
+std::size_t allocationCount();
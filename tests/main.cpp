@@ -1,14 +1,40 @@
 #include "test_objects.hpp"
 #include "test_leveldata.hpp"
+#include "test_levelsimulation.hpp"
 #include "test_states.hpp"
+#include "test_performance.hpp"
 
 
 int main () {
     testTakeDamage();
+    testSharedAssets();
+    testVoicePool();
+    testRestoreInitialState();
+    testObjectHandles();
+    testObjectPicker();
+    testViewCulling();
     testInvalidLevelFile();
     testValidLevelFile();
+    testCompiledLevelFile();
+    testWideLevel();
+    testObjectPool();
+    testMaterials();
+    testLevelsStandStill();
+    testGeneratedLevelsStandStill();
+    testSimulatedShot();
+    testTrajectoryArc();
+    testFixedStepScheduler();
+    testAwakeSet();
+    testTransformBuffer();
+    testRestDetection();
+    testProfiler();
+    testTracer();
     testMenuButtonInit();
     // testMenuButtonClickRelease();
     // testMenuButtonHover();
-    return 0;
+    // performance regressions fail the run, every check runs to report all of them
+    bool fast = testLoadTime();
+    fast = testSettleTime() && fast;
+    fast = testStepAllocations() && fast;
+    return fast ? 0 : 1;
 }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <iostream>
+#include <filesystem>
 #include "leveldata.hpp"
+#include "materials.hpp"
 
 void testInvalidLevelFile() {
     try {
@@ -38,3 +40,88 @@ void testValidLevelFile() {
         std::cout << "Test validLevelFile star succeeded!" << std::endl; 
     } else { std::cout << "Test validLevelFile star failed!" << std::endl; }
 }
+
+void testCompiledLevelFile() {
+    // compile level 1 and load both versions
+    std::string binary = (std::filesystem::temp_directory_path() / "angry_birds_test_level1.bin").string();
+    LevelFile::compile(LevelData::getLevelPath(1), binary);
+    LevelData text(LevelData::getLevelPath(1));
+    LevelData compiled(binary);
+
+    if (text.getBirds().size() == compiled.getBirds().size() && text.getPigs().size() == compiled.getPigs().size()
+        && text.getObstacles().size() == compiled.getObstacles().size()) {
+        std::cout << "Test compiledLevelFile counts succeeded!" << std::endl;
+    } else { std::cout << "Test compiledLevelFile counts failed!" << std::endl; }
+
+    bool samePositions = true;
+    for (std::size_t i = 0; i < text.getObstacles().size() && i < compiled.getObstacles().size(); ++i) {
+        if (text.getObstacles()[i]->getX() != compiled.getObstacles()[i]->getX()
+            || text.getObstacles()[i]->getY() != compiled.getObstacles()[i]->getY()) {
+            samePositions = false;
+        }
+    }
+    if (samePositions) {
+        std::cout << "Test compiledLevelFile positions succeeded!" << std::endl;
+    } else { std::cout << "Test compiledLevelFile positions failed!" << std::endl; }
+    std::filesystem::remove(binary);
+}
+
+// test that the objects of a level are allocated next to each other and outlive the level data
+void testObjectPool() {
+    std::shared_ptr<Obstacle> first, second;
+    {
+        LevelData leveldata(1);
+        first = leveldata.getObstacles()[0];
+        second = leveldata.getObstacles()[1];
+    }
+    std::ptrdiff_t distance = reinterpret_cast<char*>(second.get()) - reinterpret_cast<char*>(first.get());
+    if (distance > 0 && distance < 4096) {
+        std::cout << "Test objectPool contiguous succeeded!" << std::endl;
+    }
+    else { std::cout << "Test objectPool contiguous failed!" << std::endl; }
+    // the userdata of the body is part of the object
+    b2World world(b2Vec2(0.0f, 9.8f));
+    first->initializePhysicsWorld(world);
+    Userdata* data = reinterpret_cast<Userdata*>(first->getBody()->GetUserData().pointer);
+    if (data && data->object == first.get() && data->type == ObjectType::Obstacle) {
+        std::cout << "Test objectPool userdata succeeded!" << std::endl;
+    }
+    else { std::cout << "Test objectPool userdata failed!" << std::endl; }
+}
+
+// test reading the material table of impulse damage
+void testMaterials() {
+    const Materials& materials = Materials::getDefault();
+    if (materials[Material::Stone].resistance > materials[Material::Glass].resistance
+        && materials[Material::Yellow].multiplier > materials[Material::Red].multiplier
+        && materials[Material::Ground].damage == 0) {
+        std::cout << "Test materials succeeded!" << std::endl;
+    }
+    else { std::cout << "Test materials failed!" << std::endl; }
+    try {
+        Materials missing("../src/textfiles/nomaterials.txt");
+        std::cout << "Test materials missing failed!" << std::endl;
+    }
+    catch (const std::runtime_error& e) {
+        std::cout << "Test materials missing succeeded!" << std::endl;
+    }
+}
+
+// test that a level reaching past the window gets a ground as wide as the level
+void testWideLevel() {
+    std::string path = (std::filesystem::temp_directory_path() / "angry_birds_test_wide.txt").string();
+    {
+        std::ofstream file(path);
+        file << "Birds\nRed\n\nPigs\nNormal 5000 583\n\nObstacles\nWood 700 593\nWood 5000 593\n";
+    }
+    LevelData wide(path);
+    LevelData normal(1);
+    std::shared_ptr<Ground> ground = wide.getGround();
+    if (wide.getWidth() >= 5000 && ground->getX() + ground->getWidth() / 2 >= wide.getWidth()
+        && normal.getWidth() == LevelData::kMinWidth && normal.getGround()->getWidth() == 1385) {
+        std::cout << "Test wideLevel succeeded!" << std::endl;
+    }
+    else { std::cout << "Test wideLevel failed!" << std::endl; }
+    std::filesystem::remove(path);
+    std::filesystem::remove(LevelFile::compiledPath(path));
+}
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "levelsimulation.hpp"
+#include "levelfile.hpp"
+#include "towerlevel.hpp"
+#include "trajectorypreview.hpp"
+#include "fixedstepscheduler.hpp"
+#include "profiler.hpp"
+#include "tracer.hpp"
+
+// test shooting a bird without a window and resetting the level afterwards
+void testSimulatedShot() {
+    LevelSimulation simulation(LevelData(1));
+    int birds = simulation.birdsAlive();
+    // pull the bird back 70 pixels and let it fly for ten seconds
+    simulation.launch(0, LevelSimulation::impulseFromOffset(sf::Vector2f(-70, 10)));
+    simulation.step(600);
+    SimulationResult result = simulation.result();
+    if (simulation.birdsAlive() == birds - 1 && result.simulatedTime > 9.9f
+        && simulation.getBirds()[0]->getX() > LevelSimulation::kSlingshotX) {
+        std::cout << "Test simulatedShot launch succeeded!" << std::endl;
+    }
+    else { std::cout << "Test simulatedShot launch failed!" << std::endl; }
+    simulation.reset();
+    result = simulation.result();
+    if (simulation.birdsAlive() == birds && result.score == 0 && result.simulatedTime == 0
+        && result.status == SimulationStatus::Running) {
+        std::cout << "Test simulatedShot reset succeeded!" << std::endl;
+    }
+    else { std::cout << "Test simulatedShot reset failed!" << std::endl; }
+}
+
+// test that the closed-form preview arc matches a bird flying in Box2D
+void testTrajectoryArc() {
+    b2World world(b2Vec2(0.0f, LevelSimulation::kGravity));
+    b2BodyDef bodyDef;
+    bodyDef.type = b2_dynamicBody;
+    bodyDef.position.Set(1.45f, 5.2f);
+    b2Body* body = world.CreateBody(&bodyDef);
+    b2CircleShape shape;
+    shape.m_radius = 0.15f;
+    body->CreateFixture(&shape, 1);
+    b2Vec2 velocity(10, -5);
+    body->SetLinearVelocity(velocity);
+    std::vector<sf::Vector2f> points = TrajectoryPreview::arc(sf::Vector2f(145, 520), velocity, 600);
+    bool matches = points.size() > 10;
+    for (std::size_t i = 0; i < 10 && matches; i++) {
+        for (int step = 0; step < TrajectoryPreview::kStepsPerPoint; step++) {
+            world.Step(LevelSimulation::kTimeStep, 8, 3);
+        }
+        b2Vec2 position = body->GetPosition();
+        matches = std::abs(position.x * 100 - points[i].x) < 0.5f && std::abs(position.y * 100 - points[i].y) < 0.5f;
+    }
+    if (matches) {
+        std::cout << "Test trajectoryArc succeeded!" << std::endl;
+    }
+    else { std::cout << "Test trajectoryArc failed!" << std::endl; }
+}
+
+// test that a long frame runs at most the capped number of steps and keeps the remainder
+void testFixedStepScheduler() {
+    FixedStepScheduler scheduler(0.01, 5);
+    int steps = scheduler.advance(0.025);
+    bool normal = steps == 2 && scheduler.getLastDropped() == 0 && std::abs(scheduler.getAlpha() - 0.5f) < 0.01f;
+    // a one second hitch runs 5 steps and drops the rest
+    steps = scheduler.advance(1.0);
+    bool capped = steps == 5 && scheduler.getLastDropped() == 95 && std::abs(scheduler.getAlpha() - 0.5f) < 0.01f
+        && scheduler.getTotalSteps() == 7;
+    if (normal && capped) {
+        std::cout << "Test fixedStepScheduler succeeded!" << std::endl;
+    }
+    else { std::cout << "Test fixedStepScheduler failed!" << std::endl; }
+}
+
+// test that only moving objects are kept in the awake set
+void testAwakeSet() {
+    LevelSimulation simulation(LevelData(1));
+    std::size_t all = simulation.getAwakeSet().size();
+    // the untouched level settles and falls asleep
+    simulation.step(600);
+    std::size_t settled = simulation.getAwakeSet().size();
+    simulation.launch(0, LevelSimulation::impulseFromOffset(sf::Vector2f(-70, 10)));
+    simulation.step(1);
+    if (all > 0 && settled < all && simulation.getAwakeSet().size() > settled
+        && simulation.getBirds()[0]->getAwakeIndex() >= 0) {
+        std::cout << "Test awakeSet succeeded!" << std::endl;
+    }
+    else { std::cout << "Test awakeSet failed!" << std::endl; }
+}
+
+// test that the transform buffer draws every object where its body is, in pixels and degrees
+void testTransformBuffer() {
+    LevelSimulation simulation(LevelData(1));
+    simulation.launch(0, LevelSimulation::impulseFromOffset(sf::Vector2f(-70, 10)));
+    simulation.step(30);
+    const TransformBuffer& transforms = simulation.getTransforms();
+    bool synced = transforms.size() == simulation.getBirds().size() + simulation.getPigs().size()
+        + simulation.getObstacles().size() + (simulation.getStar() ? 1 : 0);
+    for (auto& bird : simulation.getBirds()) {
+        b2Body* body = bird->getBody();
+        synced = synced && std::abs(bird->getX() - body->GetPosition().x * 100) < 0.01f
+            && std::abs(bird->getY() - body->GetPosition().y * 100) < 0.01f
+            && std::abs(bird->getAngle() - body->GetAngle() * 180 / b2_pi) < 0.01f;
+    }
+    if (synced) {
+        std::cout << "Test transformBuffer succeeded!" << std::endl;
+    }
+    else { std::cout << "Test transformBuffer failed!" << std::endl; }
+}
+
+// test that a level at rest is recognized, so the verdict does not wait for the time limit
+void testRestDetection() {
+    LevelSimulation simulation(LevelData(1));
+    // the untouched level settles within ten seconds
+    simulation.step(600);
+    bool settled = simulation.isAtRest();
+    simulation.launch(0, LevelSimulation::impulseFromOffset(sf::Vector2f(-70, 10)));
+    simulation.step(1);
+    bool flying = !simulation.isAtRest();
+    if (settled && flying) {
+        std::cout << "Test restDetection succeeded!" << std::endl;
+    }
+    else { std::cout << "Test restDetection failed!" << std::endl; }
+}
+
+// test the percentiles and counters the profiler keeps of each frame
+void testProfiler() {
+    Profiler profiler;
+    profiler.setShown(true);
+    for (int i = 1; i <= 100; i++) {
+        profiler.beginFrame();
+        profiler.addTime(ProfileSection::Physics, i);
+        profiler.count(ProfileCounter::DrawCalls, 1);
+        profiler.count(ProfileCounter::DrawCalls, 1);
+        profiler.gauge(ProfileCounter::Bodies, i);
+        profiler.endFrame();
+    }
+    const Profiler::Frame& last = profiler.getLastFrame();
+    bool measured = profiler.getFrames() == 100 && std::abs(profiler.percentile(ProfileSection::Physics, 50) - 51) < 0.01
+        && std::abs(profiler.percentile(ProfileSection::Physics, 99) - 99) < 0.01
+        && last.counters[static_cast<std::size_t>(ProfileCounter::DrawCalls)] == 2
+        && last.counters[static_cast<std::size_t>(ProfileCounter::Bodies)] == 100;
+    // a disabled profiler ignores the frames
+    profiler.setShown(false);
+    profiler.beginFrame();
+    profiler.endFrame();
+    bool ignored = profiler.getFrames() == 100;
+    // enabling in the middle of a frame starts measuring with the next one
+    profiler.beginFrame();
+    profiler.setShown(true);
+    profiler.count(ProfileCounter::DrawCalls, 1);
+    profiler.endFrame();
+    ignored = ignored && profiler.getFrames() == 100;
+    profiler.beginFrame();
+    profiler.endFrame();
+    bool resumed = profiler.getFrames() == 101
+        && profiler.getLastFrame().counters[static_cast<std::size_t>(ProfileCounter::DrawCalls)] == 0;
+    if (measured && ignored && resumed) {
+        std::cout << "Test profiler succeeded!" << std::endl;
+    }
+    else { std::cout << "Test profiler failed!" << std::endl; }
+}
+
+// test that zones from two threads end up in the trace file
+void testTracer() {
+    std::string path = "test_trace.json";
+    Tracer& tracer = Tracer::get();
+    tracer.start(path);
+    {
+        TraceZone zone("main zone");
+        std::thread([]() { TraceZone zone("worker zone"); }).join();
+    }
+    tracer.instant("moment");
+    tracer.write();
+    std::ifstream file(path);
+    std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::remove(path.c_str());
+    // nothing is recorded once the trace is written
+    { TraceZone zone("late zone"); }
+    if (json.find("\"main zone\",\"ph\":\"X\"") != std::string::npos && json.find("\"worker zone\"") != std::string::npos
+        && json.find("\"moment\",\"ph\":\"i\"") != std::string::npos && !tracer.isEnabled()) {
+        std::cout << "Test tracer succeeded!" << std::endl;
+    }
+    else { std::cout << "Test tracer failed!" << std::endl; }
+}
+
+// hp of every pig and obstacle of a level, in order
+std::vector<int> hpOf(LevelSimulation& simulation) {
+    std::vector<int> hp;
+    for (auto& pig : simulation.getPigs()) { hp.push_back(pig->getHp()); }
+    for (auto& obstacle : simulation.getObstacles()) { hp.push_back(obstacle->getHp()); }
+    return hp;
+}
+
+// check that no pig or obstacle of a level loses hp in 600 steps without a shot
+bool standsStill(LevelData data) {
+    LevelSimulation simulation{ std::move(data) };
+    std::vector<int> before = hpOf(simulation);
+    simulation.step(600);
+    return hpOf(simulation) == before;
+}
+
+// test that the bundled levels stand without a shot, their resting weight must not break anything
+void testLevelsStandStill() {
+    bool standing = true;
+    for (int level = 1; level <= 3; level++) {
+        standing = standsStill(LevelData(level)) && standing;
+    }
+    if (standing) {
+        std::cout << "Test levelsStandStill succeeded!" << std::endl;
+    }
+    else { std::cout << "Test levelsStandStill failed!" << std::endl; }
+}
+
+// test that generated towers stand without a shot, the default ones and tall ones of mostly stone
+void testGeneratedLevelsStandStill() {
+    TowerLevel::Options tall;
+    tall.height = 25;
+    tall.mix[0] = 2;
+    tall.mix[1] = 5;
+    tall.mix[2] = 1;
+    bool standing = true;
+    for (const TowerLevel::Options& options : { TowerLevel::Options(), tall }) {
+        std::string path = (std::filesystem::temp_directory_path() / "angry_birds_test_towers.txt").string();
+        {
+            std::ofstream file(path);
+            TowerLevel(options).write(file);
+        }
+        standing = standsStill(LevelData(path)) && standing;
+        std::filesystem::remove(path);
+        std::filesystem::remove(LevelFile::compiledPath(path));
+    }
+    if (standing) {
+        std::cout << "Test generatedLevelsStandStill succeeded!" << std::endl;
+    }
+    else { std::cout << "Test generatedLevelsStandStill failed!" << std::endl; }
+}
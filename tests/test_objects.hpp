@@ -1,8 +1,13 @@
 #pragma once
 
 #include <iostream>
+#include <cmath>
 #include "bird_types.hpp"
 #include "leveldata.hpp"
+#include "assetcache.hpp"
+#include "voicepool.hpp"
+#include "objectpicker.hpp"
+#include "worldbatch.hpp"
 
 // test Object class if object is correctly destroyed
 void testTakeDamage() {
@@ -17,5 +22,120 @@ void testTakeDamage() {
     else { std::cout << "Test takeDamage failed!" << std::endl; }
 }
 
+// test that objects of the same type share one texture instead of loading their own
+void testSharedAssets() {
+    WoodObstacle first(100, 100);
+    WoodObstacle second(200, 100);
+    std::shared_ptr<sf::Texture> firstTexture = AssetCache::getTexture(first.getTextureFilePath());
+    if (AssetCache::getTexture(second.getTextureFilePath()) == firstTexture) {
+        std::cout << "Test sharedAssets texture succeeded!" << std::endl;
+    }
+    else { std::cout << "Test sharedAssets texture failed!" << std::endl; }
+    // asking the cache again returns the texture that is already loaded
+    if (AssetCache::getTexture("../src/imagefiles/wood.png") == firstTexture) {
+        std::cout << "Test sharedAssets cache succeeded!" << std::endl;
+    }
+    else { std::cout << "Test sharedAssets cache failed!" << std::endl; }
+}
+
+// test that the voice pool merges requests for the same sound and never plays more than its voices
+void testVoicePool() {
+    VoicePool voices(2);
+    std::shared_ptr<sf::SoundBuffer> wood = AssetCache::getSoundBuffer("../src/soundfiles/wood.wav");
+    std::shared_ptr<sf::SoundBuffer> glass = AssetCache::getSoundBuffer("../src/soundfiles/glass.wav");
+    std::shared_ptr<sf::SoundBuffer> stone = AssetCache::getSoundBuffer("../src/soundfiles/stone.wav");
+    for (int i = 0; i < 50; i++) { voices.request(*wood, i % 5); }
+    voices.request(*glass, 2);
+    voices.request(*stone, 1);
+    bool merged = voices.getQueued() == 3;
+    voices.flush();
+    if (merged && voices.getQueued() == 0 && voices.getPlaying() <= voices.getVoiceCount()) {
+        std::cout << "Test voicePool succeeded!" << std::endl;
+    }
+    else { std::cout << "Test voicePool failed!" << std::endl; }
+    voices.stopAll();
+}
+
+// test that an object returns to its saved state after falling and breaking
+void testRestoreInitialState() {
+    b2World world(b2Vec2(0.0f, 9.8f));
+    WoodObstacle obstacle(300, 300);
+    obstacle.initializePhysicsWorld(world);
+    int original = obstacle.getHp();
+    obstacle.saveInitialState();
+    // let it fall for a second and break it
+    for (int i = 0; i < 60; i++) { world.Step(1.0f / 60.0f, 8, 3); }
+    obstacle.Update();
+    obstacle.takeDamage(original);
+    obstacle.getBody()->SetEnabled(false);
+    obstacle.restoreInitialState();
+    if (std::abs(obstacle.getY() - 300) < 0.01 && obstacle.getSpeed() == 0) {
+        std::cout << "Test restoreInitialState position succeeded!" << std::endl;
+    }
+    else { std::cout << "Test restoreInitialState position failed!" << std::endl; }
+    if (obstacle.getHp() == original && !obstacle.isDestroyed() && obstacle.getBody()->IsEnabled()) {
+        std::cout << "Test restoreInitialState hp succeeded!" << std::endl;
+    }
+    else { std::cout << "Test restoreInitialState hp failed!" << std::endl; }
+}
+
+// test that a removed object's handle goes stale, also after its slot is reused
+void testObjectHandles() {
+    RedBird first(100, 100);
+    RedBird second(200, 100);
+    ObjectHandles handles;
+    ObjectHandle handle = handles.add(&first);
+    bool added = handles.get(handle) == &first;
+    bool removed = handles.remove(handle) && handles.get(handle) == nullptr && !handles.remove(handle);
+    ObjectHandle reused = handles.add(&second);
+    if (added && removed && reused.index == handle.index && handles.get(reused) == &second && handles.get(handle) == nullptr) {
+        std::cout << "Test objectHandles succeeded!" << std::endl;
+    }
+    else { std::cout << "Test objectHandles failed!" << std::endl; }
+    // an object is queued for removal only once
+    if (first.markForRemoval() && !first.markForRemoval() && first.isPendingRemoval()) {
+        std::cout << "Test objectHandles removal succeeded!" << std::endl;
+    }
+    else { std::cout << "Test objectHandles removal failed!" << std::endl; }
+}
+
 // test the "edge case" when bird collides with multiple objects
-//void testMultipleCollision();
\ No newline at end of file
+//void testMultipleCollision();
+// test that picking returns the object drawn on top when objects overlap
+void testObjectPicker() {
+    b2World world(b2Vec2(0.0f, 9.8f));
+    WoodObstacle below(300, 300);
+    StoneObstacle above(300, 300);
+    RedBird bird(300, 300);
+    WoodObstacle away(600, 300);
+    for (Object* object : std::initializer_list<Object*>{ &below, &above, &bird, &away }) {
+        object->initializePhysicsWorld(world);
+    }
+    below.setDrawOrder(1);
+    above.setDrawOrder(2);
+    ObjectPicker picker;
+    // obstacles are drawn over birds, and the later obstacle over the earlier one
+    bool topmost = picker.pick(world, sf::Vector2f(300, 300)) == &above;
+    bool single = picker.pick(world, sf::Vector2f(600, 300)) == &away;
+    bool empty = picker.pick(world, sf::Vector2f(1000, 100)) == nullptr;
+    if (topmost && single && empty) {
+        std::cout << "Test objectPicker succeeded!" << std::endl;
+    }
+    else { std::cout << "Test objectPicker failed!" << std::endl; }
+}
+
+// test that the world batch skips objects outside the view and counts them
+void testViewCulling() {
+    WorldBatch batch(AssetCache::getAtlas());
+    batch.setCullRect(sf::FloatRect(0, 0, 1366, 768));
+    WoodObstacle inside(700, 500);
+    WoodObstacle edge(1380, 500);      // center outside, but its end reaches into the view
+    WoodObstacle outside(5000, 500);
+    batch.add(inside);
+    batch.add(edge);
+    batch.add(outside);
+    if (batch.size() == 2 && batch.getCulled() == 1) {
+        std::cout << "Test viewCulling succeeded!" << std::endl;
+    }
+    else { std::cout << "Test viewCulling failed!" << std::endl; }
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "levelsimulation.hpp"
+#include "allocationcounter.hpp"
+
+// The performance tests return false on a regression, main() then exits with 1.
+// The baseline is read relative to the working directory, tests/ as ctest runs them.
+
+struct PerfLimit {
+    double limit;
+    double tolerance;   // percent
+};
+
+// read perf_baseline.txt, "<measurement> <limit> <tolerance>" per line
+std::map<std::string, PerfLimit> readPerfBaseline(const std::string& path = "../tests/perf_baseline.txt") {
+    std::ifstream ifs(path);
+    if (!ifs) {
+        throw std::runtime_error("Failed opening the file " + path + "!");
+    }
+    std::map<std::string, PerfLimit> baseline;
+    std::string line;
+    while (std::getline(ifs, line)) {
+        if (line.empty() || line[0] == '#') { continue; }
+        std::istringstream iss(line);
+        std::string name;
+        PerfLimit limit;
+        if (!(iss >> name >> limit.limit >> limit.tolerance)) {
+            throw std::runtime_error("Corrupted performance baseline " + path + "!");
+        }
+        baseline[name] = limit;
+    }
+    return baseline;
+}
+
+// the baseline read on the first call, empty if it cannot be read so that every check fails
+const std::map<std::string, PerfLimit>& perfBaseline() {
+    static const std::map<std::string, PerfLimit> baseline = []() {
+        try {
+            return readPerfBaseline();
+        }
+        catch (const std::runtime_error& e) {
+            std::cout << e.what() << std::endl;
+            return std::map<std::string, PerfLimit>();
+        }
+    }();
+    return baseline;
+}
+
+// check if the wall-clock measurements are skipped, ANGRY_BIRDS_SKIP_PERF_TIMING set to anything but 0
+bool skipPerfTiming(const std::string& test) {
+    const char* skip = std::getenv("ANGRY_BIRDS_SKIP_PERF_TIMING");
+    if (skip && std::string(skip) != "0") {
+        std::cout << "Test " << test << " skipped! (ANGRY_BIRDS_SKIP_PERF_TIMING is set)" << std::endl;
+        return true;
+    }
+    return false;
+}
+
+// print the measurement against its limit and check it
+bool checkPerf(const std::string& test, const std::string& name, double value) {
+    const std::map<std::string, PerfLimit>& baseline = perfBaseline();
+    auto it = baseline.find(name);
+    if (it == baseline.end()) {
+        std::cout << "Test " << test << " failed! (" << name << " missing from the baseline)" << std::endl;
+        return false;
+    }
+    double allowed = it->second.limit * (1 + it->second.tolerance / 100);
+    bool passed = value <= allowed;
+    std::cout << "Test " << test << (passed ? " succeeded!" : " failed!") << " (" << name << " " << value
+              << ", allowed " << allowed << ")" << std::endl;
+    return passed;
+}
+
+double medianOf(std::vector<double> values) {
+    std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+    return values[values.size() / 2];
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// test that level 1 loads within the baseline
+bool testLoadTime() {
+    if (skipPerfTiming("loadTime")) { return true; }
+    LevelSimulation warmup{ LevelData(1) };   // writes the compiled copy the later loads read
+    std::vector<double> times;
+    for (int i = 0; i < 5; i++) {
+        auto start = std::chrono::steady_clock::now();
+        LevelSimulation simulation{ LevelData(1) };
+        times.push_back(millisecondsSince(start));
+    }
+    return checkPerf("loadTime", "load_level1_ms", medianOf(times));
+}
+
+// test that level 1 settles within the baseline
+bool testSettleTime() {
+    if (skipPerfTiming("settleTime")) { return true; }
+    std::vector<double> times;
+    for (int i = 0; i < 3; i++) {
+        LevelSimulation simulation{ LevelData(1) };
+        auto start = std::chrono::steady_clock::now();
+        for (int step = 0; step < 600; step++) {
+            simulation.step();
+            simulation.clearSounds();
+        }
+        times.push_back(millisecondsSince(start));
+    }
+    return checkPerf("settleTime", "settle_level1_600_steps_ms", medianOf(times));
+}
+
+// test that stepping a warm level does not call operator new, Box2D's own b2Alloc is not counted
+bool testStepAllocations() {
+    LevelSimulation simulation{ LevelData(1) };
+    // the first run grows every buffer to the size the same run needs again after the reset
+    for (int step = 0; step < 600; step++) {
+        simulation.step();
+        simulation.clearSounds();
+    }
+    simulation.reset();
+    std::size_t before = allocationCount();
+    for (int step = 0; step < 600; step++) {
+        simulation.step();
+        simulation.clearSounds();
+    }
+    return checkPerf("stepAllocations", "allocations_600_steps", double(allocationCount() - before));
+}
@@ -0,0 +1,27 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "levelfile.hpp"
+
+// Compiles text level files into the binary level format read by LevelData.
+//
+// usage: angry_birds_levelc <level.txt> [<level.bin>]
+// Without an output path the compiled file is written next to the input, level1.txt -> level1.bin.
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "usage: " << argv[0] << " <level.txt> [<level.bin>]" << std::endl;
+        return 1;
+    }
+    std::string input = argv[1];
+    std::string output = argc == 3 ? argv[2] : LevelFile::compiledPath(input);
+    try {
+        LevelFile::compile(input, output);
+        LevelFile compiled(output);
+        std::cout << input << " -> " << output << " (" << compiled.size() << " records)" << std::endl;
+    }
+    catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
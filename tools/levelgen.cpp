@@ -0,0 +1,78 @@
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "towerlevel.hpp"
+
+// Writes a level of block towers for stress testing, from a hundred up to tens of thousands of blocks.
+//
+// usage: angry_birds_levelgen [options]
+//   --towers <n>                    number of towers, default 10
+//   --height <n>                    layers per tower, default 10
+//   --blocks <n>                    build towers of --height layers until n blocks are placed, overrides --towers
+//   --mix <wood>:<stone>:<glass>    relative share of each material in the layers, default 5:3:2
+//   --spacing <px>                  distance between the centers of two towers, default 90
+//   --birds <n>                     birds of the level, default 3
+//   --seed <n>                      seed of the material choice, default 1
+//   --output <file>                 write the level to a file instead of the standard output
+//
+// The towers are built by TowerLevel, see towerlevel.hpp. The level is as wide as its towers.
+
+namespace {
+    void parseMix(const std::string& text, int mix[3]) {
+        std::istringstream iss(text);
+        char colon1 = 0, colon2 = 0;
+        if (!(iss >> mix[0] >> colon1 >> mix[1] >> colon2 >> mix[2]) || colon1 != ':' || colon2 != ':'
+            || mix[0] < 0 || mix[1] < 0 || mix[2] < 0 || mix[0] + mix[1] + mix[2] == 0) {
+            throw std::runtime_error("Corrupted material mix " + text + "!");
+        }
+    }
+
+    int usage(const char* program) {
+        std::cerr << "usage: " << program << " [--towers <n>] [--height <n>] [--blocks <n>] [--mix <wood>:<stone>:<glass>]"
+                  << " [--spacing <px>] [--birds <n>] [--seed <n>] [--output <file>]" << std::endl;
+        return 1;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    TowerLevel::Options options;
+    std::string output;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) { return usage(argv[0]); }
+            else if (arg == "--towers") { options.towers = std::stoi(argv[++i]); }
+            else if (arg == "--height") { options.height = std::stoi(argv[++i]); }
+            else if (arg == "--blocks") { options.blocks = std::stol(argv[++i]); }
+            else if (arg == "--mix") { parseMix(argv[++i], options.mix); }
+            else if (arg == "--spacing") { options.spacing = std::stof(argv[++i]); }
+            else if (arg == "--birds") { options.birds = std::stoi(argv[++i]); }
+            else if (arg == "--seed") { options.seed = static_cast<unsigned>(std::stoul(argv[++i])); }
+            else if (arg == "--output") { output = argv[++i]; }
+            else { return usage(argv[0]); }
+        }
+        if (options.towers < 1 || options.height < 1 || options.blocks < 0 || options.birds < 1 || options.spacing < 60) {
+            return usage(argv[0]);
+        }
+
+        TowerLevel level(options);
+
+        std::ofstream file;
+        if (!output.empty()) {
+            file.open(output);
+            if (!file) {
+                throw std::runtime_error("Failed opening the file " + output + " for writing!");
+            }
+        }
+        std::ostream& out = output.empty() ? std::cout : file;
+        level.write(out);
+        std::cerr << level.getPigs().size() << " towers, " << level.getBlocks().size() << " blocks" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "levelsimulation.hpp"
+
+// Simulates shots at a level without a window and prints the outcome of each shot.
+//
+// usage: angry_birds_sim <level> [options]
+//   --shots <file>                  launch vectors "vx vy" in meters per second, one per line
+//   --grid <vx0> <vx1> <nx> <vy0> <vy1> <ny>
+//                                   nx * ny launch vectors evenly spaced between the limits
+//   --bird <index>                  bird to launch, default 0
+//   --seconds <s>                   longest time to simulate a shot, default 10
+//   --threads <n>                   worker threads, default one per core
+//   --format csv|json               output format, default csv
+//   --output <file>                 write the results to a file instead of the standard output
+//
+// Every worker builds the level once and resets it in place between its shots.
+
+namespace {
+    struct Shot {
+        std::size_t bird;
+        b2Vec2 impulse;
+    };
+
+    const char* statusName(SimulationStatus status) {
+        switch (status) {
+            case SimulationStatus::Running: { return "running"; }
+            case SimulationStatus::Settling: { return "settling"; }
+            case SimulationStatus::Won: { return "won"; }
+            case SimulationStatus::Lost: { return "lost"; }
+        }
+        return "";
+    }
+
+    std::vector<Shot> readShots(const std::string& path, std::size_t bird) {
+        std::ifstream ifs(path);
+        if (!ifs) {
+            throw std::runtime_error("Failed opening the file " + path + "!");
+        }
+        std::vector<Shot> shots;
+        float vx, vy;
+        while (ifs >> vx >> vy) {
+            shots.push_back(Shot{ bird, b2Vec2(vx, vy) });
+        }
+        if (!ifs.eof()) {
+            throw std::runtime_error("Corrupted shot file " + path + "!");
+        }
+        return shots;
+    }
+
+    std::vector<Shot> gridShots(float vx0, float vx1, int nx, float vy0, float vy1, int ny, std::size_t bird) {
+        std::vector<Shot> shots;
+        for (int i = 0; i < nx; i++) {
+            float vx = nx > 1 ? vx0 + (vx1 - vx0) * i / (nx - 1) : vx0;
+            for (int j = 0; j < ny; j++) {
+                float vy = ny > 1 ? vy0 + (vy1 - vy0) * j / (ny - 1) : vy0;
+                shots.push_back(Shot{ bird, b2Vec2(vx, vy) });
+            }
+        }
+        return shots;
+    }
+
+    // Resets the level, launches the bird and simulates until the verdict or the time limit.
+    SimulationResult runShot(LevelSimulation& simulation, const Shot& shot, float seconds) {
+        simulation.reset();
+        simulation.launch(shot.bird, shot.impulse);
+        int maxSteps = static_cast<int>(seconds / LevelSimulation::kTimeStep);
+        for (int i = 0; i < maxSteps; i++) {
+            simulation.step();
+            simulation.clearSounds();
+            SimulationStatus status = simulation.getStatus();
+            if (status == SimulationStatus::Won || status == SimulationStatus::Lost) {
+                break;
+            }
+        }
+        return simulation.result();
+    }
+
+    void worker(const std::string& level, const std::vector<Shot>& shots, std::vector<SimulationResult>& results,
+                std::atomic<std::size_t>& next, float seconds) {
+        LevelSimulation simulation{ LevelData(level) };
+        for (std::size_t i = next++; i < shots.size(); i = next++) {
+            results[i] = runShot(simulation, shots[i], seconds);
+        }
+    }
+
+    void writeCsv(std::ostream& out, const std::vector<Shot>& shots, const std::vector<SimulationResult>& results) {
+        out << "shot,bird,vx,vy,status,score,stars,pigs_killed,simulated_time\n";
+        for (std::size_t i = 0; i < shots.size(); i++) {
+            out << i << ',' << shots[i].bird << ',' << shots[i].impulse.x << ',' << shots[i].impulse.y << ','
+                << statusName(results[i].status) << ',' << results[i].score << ',' << results[i].stars << ','
+                << results[i].pigsKilled << ',' << results[i].simulatedTime << '\n';
+        }
+    }
+
+    void writeJson(std::ostream& out, const std::vector<Shot>& shots, const std::vector<SimulationResult>& results) {
+        out << "[\n";
+        for (std::size_t i = 0; i < shots.size(); i++) {
+            out << "  {\"shot\": " << i << ", \"bird\": " << shots[i].bird
+                << ", \"vx\": " << shots[i].impulse.x << ", \"vy\": " << shots[i].impulse.y
+                << ", \"status\": \"" << statusName(results[i].status) << "\", \"score\": " << results[i].score
+                << ", \"stars\": " << results[i].stars << ", \"pigs_killed\": " << results[i].pigsKilled
+                << ", \"simulated_time\": " << results[i].simulatedTime << "}" << (i + 1 < shots.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    }
+
+    int usage(const char* program) {
+        std::cerr << "usage: " << program << " <level> [--shots <file>] [--grid <vx0> <vx1> <nx> <vy0> <vy1> <ny>]"
+                  << " [--bird <index>] [--seconds <s>] [--threads <n>] [--format csv|json] [--output <file>]" << std::endl;
+        return 1;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        return usage(argv[0]);
+    }
+    std::string level = argv[1];
+    std::string shotFile;
+    std::vector<std::string> grid;
+    std::size_t bird = 0;
+    float seconds = 10;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string format = "csv";
+    std::string output;
+    try {
+        for (int i = 2; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--grid" && i + 6 < argc) {
+                grid.assign(argv + i + 1, argv + i + 7);
+                i += 6;
+            }
+            else if (i + 1 >= argc) { return usage(argv[0]); }
+            else if (arg == "--shots") { shotFile = argv[++i]; }
+            else if (arg == "--bird") { bird = std::stoul(argv[++i]); }
+            else if (arg == "--seconds") { seconds = std::stof(argv[++i]); }
+            else if (arg == "--threads") { threads = std::max(1, std::stoi(argv[++i])); }
+            else if (arg == "--format") { format = argv[++i]; }
+            else if (arg == "--output") { output = argv[++i]; }
+            else { return usage(argv[0]); }
+        }
+        if ((shotFile.empty() == grid.empty()) || (format != "csv" && format != "json")) {
+            return usage(argv[0]);
+        }
+
+        std::vector<Shot> shots = shotFile.empty()
+            ? gridShots(std::stof(grid[0]), std::stof(grid[1]), std::stoi(grid[2]), std::stof(grid[3]), std::stof(grid[4]), std::stoi(grid[5]), bird)
+            : readShots(shotFile, bird);
+
+        // load the level once up front: reports a broken level before any thread starts,
+        // and compiles the text level so that the workers only read the compiled copy
+        LevelSimulation check{ LevelData(level) };
+        if (bird >= check.getBirds().size()) {
+            throw std::runtime_error("The level has no bird " + std::to_string(bird) + "!");
+        }
+
+        std::vector<SimulationResult> results(shots.size());
+        std::atomic<std::size_t> next(0);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned i = 0; i < threads; i++) {
+            workers.emplace_back(worker, std::cref(level), std::cref(shots), std::ref(results), std::ref(next), seconds);
+        }
+        for (auto& thread : workers) {
+            thread.join();
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::ofstream file;
+        if (!output.empty()) {
+            file.open(output);
+            if (!file) {
+                throw std::runtime_error("Failed opening the file " + output + " for writing!");
+            }
+        }
+        std::ostream& out = output.empty() ? std::cout : file;
+        if (format == "json") { writeJson(out, shots, results); }
+        else { writeCsv(out, shots, results); }
+
+        std::cerr << shots.size() << " shots on " << threads << " threads in " << elapsed << " s ("
+                  << (elapsed > 0 ? shots.size() / elapsed : 0) << " shots/s)" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}